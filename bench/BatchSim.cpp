@@ -0,0 +1,294 @@
+// Batch game simulation: thousands of headless sessions across all cores, played by scripted
+// bots that aim and fire through GameManager::CheckShot. No GL context needed.
+// Build with -DCGTP_BUILD_BENCH=ON, then e.g.
+//   cgtp_batchsim --sessions 2000 --spawn-interval 2,3,4 --required-zoom 15,20,30 --csv sessions.csv
+// Every config x policy pair plays the same seeds, so the rows compare like for like.
+#include "GameManager.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const glm::vec3 PLAYER_POSITION(0.0f, -3.0f, 25.0f); // Spawn point in main.cpp
+const float DEFAULT_ZOOM = 45.0f;
+const float MIN_ZOOM = 5.0f; // Deepest zoom the bots use (the flythrough sweeps 45 -> 5 too)
+
+struct BotPolicy {
+    const char* Name;
+    float ReactionTime; // Seconds between picking a target and the first shot at it
+    float TurnRate;     // Degrees per second
+    float AimNoise;     // Standard deviation of the shot direction, degrees
+    float FireInterval; // Minimum seconds between clicks
+    float ZoomTime;     // Seconds to zoom across the whole range (45 -> 5 degrees)
+    bool Aims;          // false: sweeps the district and clicks blindly (mostly misses)
+};
+
+const BotPolicy POLICIES[] = {
+    { "perfect", 0.0f,  1e6f,   0.0f,  0.1f,  0.0f, true  },
+    { "skilled", 0.25f, 240.0f, 0.15f, 0.25f, 0.3f, true  },
+    { "casual",  0.5f,  120.0f, 0.4f,  0.5f,  0.6f, true  },
+    { "spray",   0.0f,  30.0f,  0.0f,  0.1f,  0.0f, false },
+};
+
+struct SessionResult {
+    int Score = 0;
+    int Shots = 0;
+    float FirstHit = -1.0f; // Seconds into the game, -1 = never
+    long Ticks = 0;
+};
+
+float Approach(float value, float target, float maxStep) {
+    float delta = target - value;
+    return std::fabs(delta) <= maxStep ? target : value + (delta > 0.0f ? maxStep : -maxStep);
+}
+
+float WrapDegrees(float angle) {
+    angle = std::fmod(angle + 180.0f, 360.0f);
+    return (angle < 0.0f ? angle + 360.0f : angle) - 180.0f;
+}
+
+// One full game; the bot acts once per tick after the simulation step
+SessionResult RunSession(const GameConfig& config, const BotPolicy& policy, uint32_t seed, float dt, int drones) {
+    GameManager game;
+    game.SetSeed(seed);
+    game.SetConfig(config);
+    if (drones > 0) {
+        game.SetDroneMode(true, drones);
+        game.GetDroneSwarm().BudgetMs = 1e9f; // Same result on every machine
+    }
+    game.StartGame();
+
+    Camera camera(PLAYER_POSITION);
+    std::mt19937 rng(seed ^ 0x9e3779b9u);
+    std::normal_distribution<float> noise(0.0f, std::max(policy.AimNoise, 1e-6f));
+    // Zoom just past the requirement: a stricter RequiredZoom costs zoom time
+    const float zoomedIn = std::max(MIN_ZOOM, config.RequiredZoom - 1.0f);
+    const float zoomRate = policy.ZoomTime > 0.0f ? (DEFAULT_ZOOM - MIN_ZOOM) / policy.ZoomTime : 1e6f;
+
+    SessionResult result;
+    unsigned int trackedSlot = ~0u;
+    float reactionLeft = 0.0f, fireCooldown = 0.0f, sweep = 1.0f;
+    float elapsed = 0.0f;
+    while (!game.IsGameOver()) {
+        game.Update(dt);
+        elapsed += dt;
+        result.Ticks++;
+        reactionLeft -= dt;
+        fireCooldown -= dt;
+
+        bool fire = false;
+        if (policy.Aims) {
+            // Target closest to the crosshair
+            const TargetPool& targets = game.GetTargets();
+            if (targets.Empty()) continue;
+            size_t best = 0;
+            float bestDot = -2.0f;
+            for (size_t i = 0; i < targets.Size(); i++) {
+                float d = glm::dot(glm::normalize(targets.PositionAt(i) - camera.Position), camera.Front);
+                if (d > bestDot) {
+                    bestDot = d;
+                    best = i;
+                }
+            }
+            unsigned int slot = targets.HandleAt(best).slot;
+            if (slot != trackedSlot) {
+                trackedSlot = slot;
+                reactionLeft = policy.ReactionTime;
+            }
+
+            glm::vec3 toTarget = targets.PositionAt(best) - camera.Position;
+            float distance = glm::length(toTarget);
+            glm::vec3 dir = toTarget / distance;
+            float yaw = glm::degrees(std::atan2(dir.z, dir.x));
+            float pitch = glm::degrees(std::asin(dir.y));
+            float turn = policy.TurnRate * dt;
+            float newYaw = camera.Yaw + Approach(0.0f, WrapDegrees(yaw - camera.Yaw), turn);
+            camera.SetPose(camera.Position, newYaw, Approach(camera.Pitch, pitch, turn));
+
+            float wantZoom = distance > config.FarDistanceThreshold ? zoomedIn : DEFAULT_ZOOM;
+            camera.Zoom = Approach(camera.Zoom, wantZoom, zoomRate * dt);
+
+            // Fire once on target (within the hit sphere's angular radius) and zoomed as wanted
+            float error = glm::degrees(std::acos(std::min(1.0f, glm::dot(camera.Front, dir))));
+            float radius = glm::degrees(std::atan(0.8f / distance));
+            fire = reactionLeft <= 0.0f && fireCooldown <= 0.0f && error < radius * 0.8f && camera.Zoom == wantZoom;
+        } else {
+            // Sweep the target district left and right, zoomed in, clicking on the interval
+            float yaw = camera.Yaw + sweep * policy.TurnRate * dt;
+            if (yaw < -150.0f || yaw > -95.0f) sweep = -sweep;
+            camera.SetPose(camera.Position, yaw, 15.0f);
+            camera.Zoom = zoomedIn;
+            fire = fireCooldown <= 0.0f;
+        }
+        if (!fire) continue;
+
+        // The shot leaves with the policy's aim noise; the view itself stays put
+        float yaw = camera.Yaw, pitch = camera.Pitch;
+        if (policy.AimNoise > 0.0f) camera.SetPose(camera.Position, yaw + noise(rng), pitch + noise(rng));
+        bool hit = false;
+        game.CheckShot(camera, hit);
+        result.Shots++;
+        if (hit && result.FirstHit < 0.0f) result.FirstHit = elapsed;
+        camera.SetPose(camera.Position, yaw, pitch);
+        fireCooldown = policy.FireInterval;
+    }
+    result.Score = game.GetScore();
+    return result;
+}
+
+std::vector<float> ParseList(const char* text) {
+    std::vector<float> values;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+        if (!item.empty()) values.push_back(std::strtof(item.c_str(), nullptr));
+    return values;
+}
+
+float Percentile(std::vector<int> values, float p) {
+    if (values.empty()) return 0.0f;
+    std::sort(values.begin(), values.end());
+    return static_cast<float>(values[std::min(values.size() - 1, static_cast<size_t>(p * values.size()))]);
+}
+
+void PrintUsage() {
+    std::printf("usage: cgtp_batchsim [--sessions N] [--threads N] [--seed N] [--policy name,...]\n"
+                "                     [--spawn-interval s,...] [--required-zoom deg,...] [--max-targets N]\n"
+                "                     [--duration s] [--dt s] [--drones N] [--csv path]\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    int sessions = 1000;
+    int threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    uint32_t baseSeed = 1;
+    float dt = 1.0f / 60.0f;
+    int drones = 0;
+    const char* csvPath = nullptr;
+    GameConfig base;
+    std::vector<float> spawnIntervals{ base.SpawnInterval };
+    std::vector<float> requiredZooms{ base.RequiredZoom };
+    std::vector<const BotPolicy*> policies;
+    for (const BotPolicy& p : POLICIES) policies.push_back(&p);
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            PrintUsage();
+            return 1;
+        }
+        i++;
+        if (!std::strcmp(arg, "--sessions")) sessions = std::atoi(value);
+        else if (!std::strcmp(arg, "--threads")) threadCount = std::max(1, std::atoi(value));
+        else if (!std::strcmp(arg, "--seed")) baseSeed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (!std::strcmp(arg, "--spawn-interval")) spawnIntervals = ParseList(value);
+        else if (!std::strcmp(arg, "--required-zoom")) requiredZooms = ParseList(value);
+        else if (!std::strcmp(arg, "--max-targets")) base.MaxTargets = std::atoi(value);
+        else if (!std::strcmp(arg, "--duration")) base.GameDuration = std::strtof(value, nullptr);
+        else if (!std::strcmp(arg, "--dt")) dt = std::strtof(value, nullptr);
+        else if (!std::strcmp(arg, "--drones")) drones = std::atoi(value);
+        else if (!std::strcmp(arg, "--csv")) csvPath = value;
+        else if (!std::strcmp(arg, "--policy")) {
+            policies.clear();
+            std::stringstream in(value);
+            std::string name;
+            while (std::getline(in, name, ','))
+                for (const BotPolicy& p : POLICIES)
+                    if (name == p.Name) policies.push_back(&p);
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (sessions < 1 || dt <= 0.0f || policies.empty() || spawnIntervals.empty() || requiredZooms.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<GameConfig> configs;
+    for (float spawn : spawnIntervals) {
+        for (float zoom : requiredZooms) {
+            GameConfig config = base;
+            config.SpawnInterval = spawn;
+            config.RequiredZoom = zoom;
+            configs.push_back(config);
+        }
+    }
+
+    // One session per index on the job system; this thread plays too, so threadCount - 1 workers
+    const size_t groups = configs.size() * policies.size();
+    const size_t jobCount = groups * sessions;
+    std::vector<SessionResult> results(jobCount);
+    JobSystem::Init(threadCount - 1);
+    auto start = std::chrono::steady_clock::now();
+    JobSystem::ParallelFor(jobCount, 1, [&](size_t begin, size_t end) {
+        for (size_t job = begin; job < end; job++) {
+            size_t group = job / sessions;
+            const GameConfig& config = configs[group / policies.size()];
+            const BotPolicy& policy = *policies[group % policies.size()];
+            results[job] = RunSession(config, policy, baseSeed + static_cast<uint32_t>(job % sessions), dt, drones);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long ticks = 0;
+    for (const SessionResult& r : results) ticks += r.Ticks;
+    std::printf("%zu sessions on %d threads in %.2f s: %.0f sessions/s, %.2fM ticks/s (%.0fx real time)\n\n",
+        jobCount, threadCount, seconds, jobCount / seconds, ticks / seconds / 1e6, ticks * dt / seconds);
+
+    std::printf("spawn_s  zoom_deg  policy    score_mean  p10   p50   p90   accuracy  first_hit_s\n");
+    for (size_t group = 0; group < groups; group++) {
+        const GameConfig& config = configs[group / policies.size()];
+        const BotPolicy& policy = *policies[group % policies.size()];
+        std::vector<int> scores;
+        long shots = 0, hits = 0;
+        double firstHit = 0.0;
+        int firstHitCount = 0;
+        for (int s = 0; s < sessions; s++) {
+            const SessionResult& r = results[group * sessions + s];
+            scores.push_back(r.Score);
+            shots += r.Shots;
+            hits += r.Score;
+            if (r.FirstHit >= 0.0f) {
+                firstHit += r.FirstHit;
+                firstHitCount++;
+            }
+        }
+        std::printf("%-8.2f %-9.1f %-9s %-11.2f %-5.0f %-5.0f %-5.0f %-9.3f %.2f\n",
+            config.SpawnInterval, config.RequiredZoom, policy.Name, static_cast<double>(hits) / sessions,
+            Percentile(scores, 0.1f), Percentile(scores, 0.5f), Percentile(scores, 0.9f),
+            shots > 0 ? static_cast<double>(hits) / shots : 0.0, firstHitCount > 0 ? firstHit / firstHitCount : -1.0);
+    }
+
+    if (csvPath) {
+        FILE* csv = std::fopen(csvPath, "w");
+        if (!csv) {
+            std::printf("ERROR::BATCHSIM:: cannot write %s\n", csvPath);
+            return 1;
+        }
+        std::fprintf(csv, "spawn_interval,required_zoom,policy,seed,score,shots,first_hit_s,ticks\n");
+        for (size_t job = 0; job < jobCount; job++) {
+            size_t group = job / sessions;
+            const GameConfig& config = configs[group / policies.size()];
+            const SessionResult& r = results[job];
+            std::fprintf(csv, "%.3f,%.3f,%s,%u,%d,%d,%.3f,%ld\n", config.SpawnInterval, config.RequiredZoom,
+                policies[group % policies.size()]->Name, baseSeed + static_cast<uint32_t>(job % sessions),
+                r.Score, r.Shots, r.FirstHit, r.Ticks);
+        }
+        std::fclose(csv);
+    }
+    return 0;
+}
@@ -0,0 +1,242 @@
+// Google Benchmark suite for the CPU hot paths of loading and one game frame.
+// No GL context needed: models load with upload = false and GameManager holds no GL state.
+// Build with -DCGTP_BUILD_BENCH=ON; run from the build directory (needs assets/), or use the
+// cgtp_bench_run target, which writes bench_results.json. Each benchmark counts only the
+// function under test; fixtures are built once and shared.
+#include <benchmark/benchmark.h>
+
+#include "Model.h"
+#include "Camera.h"
+#include "GameManager.h"
+#include "Frustum.h"
+#include "JobSystem.h"
+
+#include <iostream>
+#include <memory>
+
+namespace {
+
+const char* CITY_PATH = "assets/CuberpunkCityWithKaws.glb";
+const char* CITY_DIRECTORY = "assets";
+const char* BAKE_PATH = "assets/City_Bake_4K.png";
+
+// Same placement as main.cpp
+glm::mat4 CityMatrix() {
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -5.0f, -10.0f));
+    m = glm::rotate(m, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    m = glm::rotate(m, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return glm::scale(m, glm::vec3(10.0f));
+}
+
+// Model logs every mesh and texture it loads; keep that out of the timings
+struct QuietCout {
+    QuietCout() { std::cout.setstate(std::ios::failbit); }
+    ~QuietCout() { std::cout.clear(); }
+};
+
+// The city scene, imported once (BM_AssimpImport measures the import itself)
+const aiScene* CityScene() {
+    static Assimp::Importer importer;
+    static const aiScene* scene = importer.ReadFile(CITY_PATH, Model::IMPORT_FLAGS);
+    return scene && scene->mRootNode && !(scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) ? scene : nullptr;
+}
+
+// The city converted once, CPU-side only; null when the asset is missing
+const Model* CityModel() {
+    static std::unique_ptr<Model> model;
+    if (!model && CityScene()) {
+        QuietCout quiet;
+        model.reset(new Model(CityScene(), CITY_DIRECTORY, false));
+    }
+    return model.get();
+}
+
+// Building bounds the drones avoid, filtered like main.cpp
+std::vector<AABB> CityBuildings() {
+    std::vector<AABB> buildings;
+    if (const Model* city = CityModel()) {
+        for (const Mesh& mesh : city->meshes) {
+            if (!mesh.Bounds.IsValid()) continue;
+            AABB world = mesh.Bounds.Transformed(CityMatrix());
+            if (world.Extent().x > 60.0f || world.Extent().z > 60.0f) continue;
+            buildings.push_back(world);
+        }
+    }
+    return buildings;
+}
+
+// Seeded game with a flock of count drones (count = 0: the static target mode)
+void StartGame(GameManager& game, int count) {
+    JobSystem::Init(); // The drone kernel spreads over the workers, as in the game
+    game.SetSeed(1);
+    game.SetDroneMode(count > 0, count);
+    game.GetDroneSwarm().BudgetMs = 1e9f; // Step every drone, whatever the machine
+    if (count > 0) game.SetObstacles(CityBuildings());
+    game.StartGame();
+}
+
+// Player on the street, zoomed in and looking through the middle of the drone volume
+Camera AimedCamera() {
+    Camera camera(glm::vec3(-45.0f, 27.0f, 0.0f));
+    camera.Zoom = 10.0f; // Far targets count only when zoomed
+    return camera;
+}
+
+// --- Loading ---
+
+void BM_AssimpImport(benchmark::State& state) {
+    for (auto _ : state) {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(CITY_PATH, Model::IMPORT_FLAGS);
+        if (!scene) {
+            state.SkipWithError(importer.GetErrorString());
+            break;
+        }
+        benchmark::DoNotOptimize(scene);
+    }
+}
+BENCHMARK(BM_AssimpImport)->Unit(benchmark::kMillisecond);
+
+// processNode / processMesh over an imported scene (texture decode included)
+void BM_MeshConversion(benchmark::State& state) {
+    const aiScene* scene = CityScene();
+    if (!scene) {
+        state.SkipWithError("cannot import the city model");
+        return;
+    }
+    QuietCout quiet;
+    size_t vertices = 0;
+    for (auto _ : state) {
+        Model model(scene, CITY_DIRECTORY, false);
+        vertices = 0;
+        for (const Mesh& mesh : model.meshes) vertices += mesh.vertices.size();
+        benchmark::DoNotOptimize(vertices);
+    }
+    state.counters["vertices"] = static_cast<double>(vertices);
+    state.SetItemsProcessed(state.iterations() * vertices);
+}
+BENCHMARK(BM_MeshConversion)->Unit(benchmark::kMillisecond);
+
+void BM_BakeDecode(benchmark::State& state) {
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        int width, height, components;
+        unsigned char* data = stbi_load(BAKE_PATH, &width, &height, &components, 0);
+        if (!data) {
+            state.SkipWithError("cannot decode the lightmap bake");
+            break;
+        }
+        stbi_image_free(data);
+        bytes = static_cast<int64_t>(width) * height * components;
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_BakeDecode)->Unit(benchmark::kMillisecond);
+
+// --- Per frame ---
+
+void BM_CheckShot(benchmark::State& state) {
+    GameManager game;
+    StartGame(game, static_cast<int>(state.range(0)));
+    Camera camera = AimedCamera();
+    int64_t hits = 0;
+    for (auto _ : state) {
+        bool hit = false;
+        benchmark::DoNotOptimize(game.CheckShot(camera, hit));
+        if (hit) {
+            // A hit removes its target: restore the flock so every shot sees the same count
+            state.PauseTiming();
+            hits++;
+            game.StartGame();
+            state.ResumeTiming();
+        }
+    }
+    state.counters["hit_rate"] = benchmark::Counter(static_cast<double>(hits) / state.iterations());
+}
+BENCHMARK(BM_CheckShot)->Arg(10)->Arg(64)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// The narrow-phase test alone, against every target
+void BM_RaySphereIntersect(benchmark::State& state) {
+    GameManager game;
+    StartGame(game, static_cast<int>(state.range(0)));
+    const TargetPool& targets = game.GetTargets();
+    std::vector<glm::vec3> positions;
+    for (size_t i = 0; i < targets.Size(); i++) positions.push_back(targets.PositionAt(i));
+    Camera camera = AimedCamera();
+    for (auto _ : state) {
+        int hits = 0;
+        for (const glm::vec3& p : positions)
+            hits += GameManager::RaySphereIntersect(camera.Position, camera.Front, p, 0.8f);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_RaySphereIntersect)->Arg(10)->Arg(1000)->Arg(100000);
+
+// One 60 Hz tick; 0 = static targets, otherwise a flock of that many drones
+void BM_GameManagerUpdate(benchmark::State& state) {
+    GameManager game;
+    StartGame(game, static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        game.Update(1.0f / 60.0f);
+        if (game.GetTimeLeft() < 1.0f) {
+            state.PauseTiming();
+            game.StartGame();
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_GameManagerUpdate)->Arg(0)->Arg(1000)->Arg(5000)->Arg(20000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Visual lock cone query of the HUD
+void BM_TargetsInView(benchmark::State& state) {
+    GameManager game;
+    StartGame(game, static_cast<int>(state.range(0)));
+    Camera camera = AimedCamera();
+    std::vector<unsigned int> slots;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(game.GetTargetsInView(camera, 10.0f, &slots));
+}
+BENCHMARK(BM_TargetsInView)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Mouse look plus the matrices a frame builds from it
+void BM_CameraMatrices(benchmark::State& state) {
+    Camera camera(glm::vec3(0.0f, -3.0f, 25.0f));
+    float direction = 1.0f;
+    for (auto _ : state) {
+        camera.ProcessMouseMovement(3.0f * direction, 1.0f * direction);
+        direction = -direction;
+        glm::mat4 viewProjection = camera.GetProjectionMatrix(16.0f / 9.0f, 0.1f, 1000.0f) * camera.GetViewMatrix();
+        benchmark::DoNotOptimize(viewProjection);
+    }
+}
+BENCHMARK(BM_CameraMatrices);
+
+// Frustum extraction plus a test of every city mesh (what Model::Draw does with cached bounds)
+void BM_FrustumCullCity(benchmark::State& state) {
+    const Model* city = CityModel();
+    if (!city) {
+        state.SkipWithError("cannot import the city model");
+        return;
+    }
+    std::vector<AABB> bounds;
+    for (const Mesh& mesh : city->meshes)
+        if (mesh.Bounds.IsValid()) bounds.push_back(mesh.Bounds.Transformed(CityMatrix()));
+    Camera camera(glm::vec3(0.0f, -3.0f, 25.0f));
+    glm::mat4 viewProjection = camera.GetProjectionMatrix(16.0f / 9.0f, 0.1f, 1000.0f) * camera.GetViewMatrix();
+    int visible = 0;
+    for (auto _ : state) {
+        Frustum frustum(viewProjection);
+        visible = 0;
+        for (const AABB& box : bounds) visible += frustum.Intersects(box);
+        benchmark::DoNotOptimize(visible);
+    }
+    state.counters["meshes"] = static_cast<double>(bounds.size());
+    state.counters["visible"] = visible;
+    state.SetItemsProcessed(state.iterations() * bounds.size());
+}
+BENCHMARK(BM_FrustumCullCity);
+
+}
+
+BENCHMARK_MAIN();
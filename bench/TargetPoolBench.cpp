@@ -0,0 +1,123 @@
+// Microbenchmark: AoS std::vector<Target> + erase vs. the SoA TargetPool, 1M targets.
+// No GL context needed. Build with -DCGTP_BUILD_BENCH=ON, run cgtp_bench_targets [count].
+#include "TargetPool.h"
+#include "TargetGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+// The old layout, kept here only as the baseline
+struct TargetAoS {
+    glm::vec3 position;
+    float activeTime;
+    bool isActive;
+};
+
+template <typename F>
+double TimeMs(F&& fn, int repeat = 1) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeat; i++) fn();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / repeat;
+}
+
+volatile float sink; // Keeps results alive
+
+}
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    if (count < 2) {
+        std::printf("usage: %s [count >= 2]\n", argv[0]);
+        return 1;
+    }
+    // Victims come from the first count - removals, so every erase stays in range
+    const size_t removals = std::min<size_t>(10000, count / 2);
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> X(-80.0f, -10.0f), Y(10.0f, 50.0f), Z(-100.0f, -20.0f);
+
+    std::vector<glm::vec3> positions(count);
+    for (auto& p : positions) p = glm::vec3(X(rng), Y(rng), Z(rng));
+
+    std::vector<TargetAoS> aos;
+    aos.reserve(count);
+    for (const auto& p : positions) aos.push_back({ p, 0.0f, true });
+
+    TargetPool pool;
+    TargetGrid grid(8.0f, 0.8f);
+    pool.Reserve(count);
+    std::vector<TargetHandle> handles;
+    handles.reserve(count);
+    double buildMs = TimeMs([&] {
+        for (const auto& p : positions) {
+            TargetHandle h = pool.Create(p);
+            grid.Insert(h.slot, p);
+            handles.push_back(h);
+        }
+    });
+
+    std::printf("targets: %zu (pool+grid build %.2f ms)\n", count, buildMs);
+    std::printf("%-28s %12s %12s\n", "operation", "AoS ms", "SoA ms");
+
+    // 1. Aging (GameManager::Update)
+    double aosAge = TimeMs([&] { for (auto& t : aos) t.activeTime += 0.016f; }, 20);
+    double soaAge = TimeMs([&] { pool.Age(0.016f); }, 20);
+    std::printf("%-28s %12.3f %12.3f\n", "age", aosAge, soaAge);
+
+    // 2. Brute-force ray scan (CheckShot without the grid)
+    glm::vec3 origin(0.0f, -3.0f, 25.0f);
+    glm::vec3 dir = glm::normalize(glm::vec3(-45.0f, 30.0f, -60.0f) - origin);
+    double aosRay = TimeMs([&] {
+        float best = 1e30f;
+        for (const auto& t : aos) {
+            glm::vec3 v = t.position - origin;
+            float tc = glm::dot(v, dir);
+            float len2 = glm::dot(v, v);
+            if (t.isActive && tc > 0.0f && len2 - tc * tc < 0.64f && len2 < best) best = len2;
+        }
+        sink = best;
+    }, 20);
+    double soaRay = TimeMs([&] { sink = (float)pool.RayScan(origin, dir, 0.8f, 1000.0f); }, 20);
+    std::printf("%-28s %12.3f %12.3f\n", "ray scan", aosRay, soaRay);
+
+    // 3. Grid ray query (broad phase only, what CheckShot uses above the scan limit)
+    std::vector<unsigned int> candidates;
+    double gridRay = TimeMs([&] { grid.RayQuery(origin, dir, 1000.0f, candidates); }, 20);
+    std::printf("%-28s %12s %12.3f  (%zu candidates)\n", "grid ray query", "-", gridRay, candidates.size());
+
+    // 4. Instance buffer fill
+    std::vector<float> instances(count * 3);
+    double aosFill = TimeMs([&] {
+        for (size_t i = 0; i < aos.size(); i++) {
+            instances[i * 3 + 0] = aos[i].position.x;
+            instances[i * 3 + 1] = aos[i].position.y;
+            instances[i * 3 + 2] = aos[i].position.z;
+        }
+    }, 20);
+    double soaFill = TimeMs([&] { pool.FillInstanceOffsets(instances.data()); }, 20);
+    std::printf("%-28s %12.3f %12.3f\n", "instance fill", aosFill, soaFill);
+
+    // 5. Random removals: vector::erase vs. swap-remove
+    std::vector<size_t> victims(removals);
+    for (auto& v : victims) v = rng() % (count - removals);
+    double aosErase = TimeMs([&] {
+        for (size_t v : victims) aos.erase(aos.begin() + v);
+    });
+    double soaErase = TimeMs([&] {
+        for (size_t v : victims) {
+            TargetHandle h = handles[v];
+            if (!pool.IsValid(h)) continue; // Already gone (duplicate victim)
+            grid.Remove(h.slot);
+            pool.Destroy(h);
+        }
+    });
+    std::printf("%-28s %12.3f %12.3f  (%zu removals, SoA includes grid)\n", "remove", aosErase, soaErase, removals);
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+# Performance regression gate for one canned headless run (see CGTP_PERF_GATE in CMakeLists.txt).
+#
+#   cmake -DEXE=<game> -DCASE=<name> -DARGS=<arg|arg|...> -DOUT_DIR=<dir> -DBASELINE=<json>
+#         [-DUPDATE=ON] [-DTIME_TOLERANCE=25] [-DMEMORY_TOLERANCE=10] [-DCOUNT_TOLERANCE=2]
+#         [-DTIME_SLACK_MS=0.5] [-DALLOW_MISSING_BASELINE=ON] -P perf_gate.cmake
+#
+# Runs the game with ARGS, reads OUT_DIR/benchmark.json and compares it with BASELINE (an earlier
+# benchmark.json of the same case). A metric regresses when it grows by more than its tolerance
+# (percent; frame times also get TIME_SLACK_MS of absolute slack so sub-millisecond noise on
+# software GL does not fail the gate). Improvements never fail, they only suggest a new baseline.
+# UPDATE=ON copies the result over the baseline instead of comparing. A missing baseline fails the
+# case; with ALLOW_MISSING_BASELINE=ON it is skipped instead (ctest matches the "skipped" line, see
+# CGTP_PERF_ALLOW_MISSING_BASELINE in CMakeLists.txt).
+cmake_minimum_required(VERSION 3.19) # string(JSON)
+
+foreach(required EXE CASE ARGS OUT_DIR BASELINE)
+    if(NOT DEFINED ${required})
+        message(FATAL_ERROR "perf_gate.cmake: -D${required}=... is required")
+    endif()
+endforeach()
+if(NOT DEFINED TIME_TOLERANCE)
+    set(TIME_TOLERANCE 25)
+endif()
+if(NOT DEFINED MEMORY_TOLERANCE)
+    set(MEMORY_TOLERANCE 10)
+endif()
+if(NOT DEFINED COUNT_TOLERANCE)
+    set(COUNT_TOLERANCE 2)
+endif()
+if(NOT DEFINED TIME_SLACK_MS)
+    set(TIME_SLACK_MS 0.5)
+endif()
+
+# JSON numbers from BenchmarkReport are plain decimals; math() only knows integers,
+# so everything is compared in thousandths
+function(to_milli value out)
+    if(value MATCHES "^(-?)([0-9]*)\\.?([0-9]*)$")
+        set(sign "${CMAKE_MATCH_1}")
+        set(whole "${CMAKE_MATCH_2}")
+        string(SUBSTRING "${CMAKE_MATCH_3}000" 0 3 fraction)
+        if(whole STREQUAL "")
+            set(whole 0)
+        endif()
+        string(REGEX REPLACE "^0+([0-9])" "\\1" fraction "${fraction}")
+        math(EXPR result "${whole} * 1000 + ${fraction}")
+        set(${out} "${sign}${result}" PARENT_SCOPE)
+    else()
+        message(FATAL_ERROR "perf_gate.cmake: not a number: '${value}'")
+    endif()
+endfunction()
+
+# Thousandths back to a 2-decimal string for the report
+function(format_milli milli out)
+    set(sign "")
+    if(milli LESS 0)
+        set(sign "-")
+        math(EXPR milli "-(${milli})")
+    endif()
+    math(EXPR hundredths "(${milli} + 5) / 10")
+    math(EXPR whole "${hundredths} / 100")
+    math(EXPR fraction "${hundredths} % 100")
+    if(fraction LESS 10)
+        set(fraction "0${fraction}")
+    endif()
+    set(${out} "${sign}${whole}.${fraction}" PARENT_SCOPE)
+endfunction()
+
+function(pad text width out)
+    string(LENGTH "${text}" length)
+    while(length LESS width)
+        string(APPEND text " ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+# Nothing to compare with: decide before spending minutes on the run
+if(NOT UPDATE AND NOT EXISTS "${BASELINE}")
+    set(hint "Record one on the reference machine (cmake --build . --target cgtp_perf_baseline) and commit it.")
+    if(NOT ALLOW_MISSING_BASELINE)
+        message(FATAL_ERROR "perf ${CASE}: no baseline at ${BASELINE}\n${hint}")
+    endif()
+    message(STATUS "perf ${CASE}: no baseline at ${BASELINE}, skipped (ALLOW_MISSING_BASELINE)\n${hint}")
+    return()
+endif()
+
+# --- Run ---
+string(REPLACE "|" ";" ARGS "${ARGS}")
+file(REMOVE_RECURSE "${OUT_DIR}")
+execute_process(
+    COMMAND "${EXE}" ${ARGS} --out "${OUT_DIR}"
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output
+    TIMEOUT 1800)
+if(NOT result EQUAL 0 OR NOT EXISTS "${OUT_DIR}/benchmark.json")
+    message(FATAL_ERROR "perf ${CASE}: run failed (${result})\n${output}")
+endif()
+file(READ "${OUT_DIR}/benchmark.json" current)
+
+if(UPDATE)
+    get_filename_component(baselineDir "${BASELINE}" DIRECTORY)
+    file(MAKE_DIRECTORY "${baselineDir}")
+    file(WRITE "${BASELINE}" "${current}")
+    message(STATUS "perf ${CASE}: baseline written to ${BASELINE}")
+    return()
+endif()
+
+file(READ "${BASELINE}" baseline)
+
+# --- Comparable at all? ---
+set(mismatch "")
+foreach(name path.hash path.revision frames resolution aa drones dynamic_resolution)
+    string(REPLACE "." ";" key "${name}")
+    string(JSON a ERROR_VARIABLE error GET "${baseline}" ${key})
+    string(JSON b ERROR_VARIABLE error GET "${current}" ${key})
+    if(NOT a STREQUAL b)
+        string(APPEND mismatch "  ${name}: baseline ${a}, current ${b}\n")
+    endif()
+endforeach()
+if(NOT mismatch STREQUAL "")
+    message(FATAL_ERROR "perf ${CASE}: the baseline was recorded for a different setup, re-record it:\n${mismatch}")
+endif()
+string(JSON baselineRenderer GET "${baseline}" renderer)
+string(JSON currentRenderer GET "${current}" renderer)
+if(NOT baselineRenderer STREQUAL currentRenderer)
+    message(WARNING "perf ${CASE}: baseline renderer '${baselineRenderer}', running on '${currentRenderer}'")
+endif()
+
+# --- Metrics: label | kind | JSON path (dotted) ---
+set(metrics
+    "load time (ms)|time|load_ms"
+    "peak RSS (MB)|memory|peak_rss_mb"
+    "render targets (MB)|memory|render_target_mb")
+foreach(group cpu_ms gpu_ms)
+    foreach(p p50 p95 p99)
+        list(APPEND metrics "overall ${group} ${p}|time|overall.${group}.${p}")
+    endforeach()
+endforeach()
+list(APPEND metrics
+    "overall draw calls|count|overall.draw_calls"
+    "overall triangles|count|overall.triangles")
+string(JSON segmentCount LENGTH "${current}" segments)
+math(EXPR lastSegment "${segmentCount} - 1")
+foreach(s RANGE ${lastSegment})
+    string(JSON segmentName GET "${current}" segments ${s} name)
+    list(APPEND metrics
+        "${segmentName} cpu_ms p95|time|segments.${s}.cpu_ms.p95"
+        "${segmentName} gpu_ms p95|time|segments.${s}.gpu_ms.p95")
+endforeach()
+
+to_milli("${TIME_SLACK_MS}" slackMilli)
+set(regressions 0)
+set(improvements 0)
+pad("metric" 34 header)
+set(report "perf ${CASE}: ${currentRenderer}\n  ${header}  baseline     current      change   limit\n")
+foreach(metric IN LISTS metrics)
+    string(REPLACE "|" ";" fields "${metric}")
+    list(GET fields 0 label)
+    list(GET fields 1 kind)
+    list(GET fields 2 key)
+    string(REPLACE "." ";" key "${key}")
+    string(JSON a ERROR_VARIABLE errorA GET "${baseline}" ${key})
+    string(JSON b ERROR_VARIABLE errorB GET "${current}" ${key})
+    if(errorA OR errorB)
+        continue() # Metric added after the baseline was recorded
+    endif()
+    to_milli("${a}" aMilli)
+    to_milli("${b}" bMilli)
+
+    if(kind STREQUAL "time")
+        set(tolerance ${TIME_TOLERANCE})
+        set(slack ${slackMilli})
+    elseif(kind STREQUAL "memory")
+        set(tolerance ${MEMORY_TOLERANCE})
+        set(slack 0)
+    else()
+        set(tolerance ${COUNT_TOLERANCE})
+        set(slack 0)
+    endif()
+    math(EXPR limit "${aMilli} * (100 + ${tolerance}) / 100 + ${slack}")
+    math(EXPR floor "${aMilli} * (100 - ${tolerance}) / 100 - ${slack}")
+
+    # Change in tenths of a percent
+    if(aMilli EQUAL 0)
+        set(change "-")
+    else()
+        math(EXPR permille "(${bMilli} - ${aMilli}) * 1000 / ${aMilli}")
+        math(EXPR whole "${permille} / 10")
+        math(EXPR tenth "(${permille} % 10)")
+        string(REPLACE "-" "" tenth "${tenth}")
+        if(permille LESS 0 AND whole EQUAL 0)
+            set(whole "-0")
+        elseif(permille GREATER_EQUAL 0)
+            set(whole "+${whole}")
+        endif()
+        set(change "${whole}.${tenth}%")
+    endif()
+
+    if(bMilli GREATER limit)
+        set(verdict "REGRESSION")
+        math(EXPR regressions "${regressions} + 1")
+    elseif(bMilli LESS floor)
+        set(verdict "improved")
+        math(EXPR improvements "${improvements} + 1")
+    else()
+        set(verdict "ok")
+    endif()
+
+    pad("${label}" 34 c0)
+    format_milli(${aMilli} aText)
+    format_milli(${bMilli} bText)
+    pad("${aText}" 12 c1)
+    pad("${bText}" 12 c2)
+    pad("${change}" 8 c3)
+    pad("+${tolerance}%" 7 c4)
+    string(APPEND report "  ${c0}  ${c1} ${c2} ${c3} ${c4} ${verdict}\n")
+endforeach()
+
+file(WRITE "${OUT_DIR}/perf_gate.txt" "${report}")
+if(regressions GREATER 0)
+    message(FATAL_ERROR "${report}perf ${CASE}: ${regressions} metric(s) regressed beyond tolerance")
+endif()
+message(STATUS "${report}perf ${CASE}: passed")
+if(improvements GREATER 0)
+    message(STATUS "perf ${CASE}: ${improvements} metric(s) improved, consider re-recording the baseline")
+endif()
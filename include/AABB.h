@@ -0,0 +1,39 @@
+#ifndef AABB_H
+#define AABB_H
+
+#include <glm/glm.hpp>
+#include <cfloat>
+
+// Axis-aligned bounding box in world (or model) space
+struct AABB {
+    glm::vec3 Min = glm::vec3(FLT_MAX);
+    glm::vec3 Max = glm::vec3(-FLT_MAX);
+
+    AABB() = default;
+    AABB(const glm::vec3& min, const glm::vec3& max) : Min(min), Max(max) {}
+
+    bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+    glm::vec3 Center() const { return (Min + Max) * 0.5f; }
+    glm::vec3 Extent() const { return Max - Min; }
+
+    void Expand(const glm::vec3& p) {
+        Min = glm::min(Min, p);
+        Max = glm::max(Max, p);
+    }
+
+    bool Contains(const glm::vec3& p) const {
+        return p.x >= Min.x && p.x <= Max.x && p.y >= Min.y && p.y <= Max.y && p.z >= Min.z && p.z <= Max.z;
+    }
+
+    // Bounds of the 8 transformed corners
+    AABB Transformed(const glm::mat4& m) const {
+        AABB out;
+        for (int i = 0; i < 8; i++) {
+            glm::vec3 corner((i & 1) ? Max.x : Min.x, (i & 2) ? Max.y : Min.y, (i & 4) ? Max.z : Min.z);
+            out.Expand(glm::vec3(m * glm::vec4(corner, 1.0f)));
+        }
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include "FrameStats.h"
+#include "RenderStats.h"
+#include <string>
+#include <vector>
+
+class CameraPath;
+
+// Per-frame results of a headless run, split by camera path segment for the report.
+// frames.csv keeps every frame; benchmark.json has the percentiles per segment along
+// with what is needed to tell whether two reports are comparable at all (path name,
+// revision and hash, renderer, resolution, AA mode) and the run's load time and memory.
+class BenchmarkReport {
+public:
+    static const int FORMAT_VERSION = 1;
+
+    struct Frame {
+        int Segment = -1;            // Index into the path's segments, -1 without a path
+        float CpuMs = 0.0f;
+        float GpuMs = -1.0f;         // -1: dropped by the GPU profiler
+        RenderStats::Counters Stats;
+    };
+
+    std::vector<Frame> Frames;
+    std::string Renderer;
+    std::string GLVersion;
+    std::string AAMode;
+    int Width = 0, Height = 0;
+    bool DynamicResolution = false;
+    int Drones = 0;
+    float LoadMs = 0.0f;          // Startup until the first frame
+    float PeakRssMb = 0.0f;       // Process peak resident set
+    float RenderTargetMb = 0.0f;  // Peak render target pool size (what the frame graph allocates)
+
+    // Peak resident set of this process so far, 0 where the platform has no query
+    static float QueryPeakRssMb();
+
+    bool WriteCsv(const std::string& file, const CameraPath* path) const;
+    bool WriteJson(const std::string& file, const CameraPath& path) const;
+};
+
+#endif
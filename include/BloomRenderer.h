@@ -0,0 +1,38 @@
+#ifndef BLOOMRENDERER_H
+#define BLOOMRENDERER_H
+
+#include <glad/glad.h>
+#include <vector>
+
+#include "Shader.h"
+#include "RenderTargetPool.h"
+
+// Progressive downsample/upsample bloom.
+// The bright part of the scene is filtered down a chain of half-size targets
+// (13-tap downsample, threshold + Karis average on the first level), then
+// blended back up with a 3x3 tent filter. Every pass after the first runs at
+// quarter the pixels of the previous one, so the whole chain costs less than
+// a single full-resolution blur pass.
+class BloomRenderer {
+public:
+    float Threshold = 0.95f;   // Same luminance cut as the legacy extract pass
+    float Knee = 0.2f;         // Soft transition around the threshold
+    float FilterRadius = 1.0f; // Tent radius in texels of the level being upsampled
+
+    explicit BloomRenderer(int mipCount = 6);
+    ~BloomRenderer();
+
+    // Filter sourceTexture (full resolution HDR) into output, which is the first (half-size) level;
+    // the smaller levels are taken from pool for the duration of the call. quadVAO is a fullscreen quad.
+    void Render(RenderTargetPool& pool, unsigned int sourceTexture, Framebuffer* output, unsigned int quadVAO);
+    int GetMipCount() const { return lastMipCount; }
+
+private:
+    Shader* DownsampleShader;
+    Shader* UpsampleShader;
+    std::vector<Framebuffer*> mips; // Valid during Render only; mips[0] is the output
+    int maxMips;
+    int lastMipCount;
+};
+
+#endif
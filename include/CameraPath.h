@@ -0,0 +1,61 @@
+#ifndef CAMERAPATH_H
+#define CAMERAPATH_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Scripted camera path for the flythrough benchmark (assets/paths/*.path):
+//   cgtp-camera-path 1           format version, first line
+//   name city_flythrough
+//   revision 1                   bump on every edit of the keys
+//   frames 2520                  frames the benchmark renders over the whole path
+//   segment street_level         keys below belong to this segment
+//   key <time> <x> <y> <z> <yaw> <pitch> <zoom>
+// Position, angles and zoom follow a Catmull-Rom spline through the keys. A segment
+// runs from its first key to the first key of the next one. Results carry the name,
+// revision and a hash of the file, so only runs of the very same path get compared.
+class CameraPath {
+public:
+    static const int FORMAT_VERSION = 1;
+
+    struct Pose {
+        glm::vec3 Position;
+        float Yaw, Pitch, Zoom;
+    };
+
+    struct Segment {
+        std::string Name;
+        float StartTime;
+    };
+
+    bool Load(const std::string& path, std::string& error);
+
+    // Pose at time (seconds, clamped to the path)
+    Pose Evaluate(float time) const;
+    // Index into GetSegments of the segment running at time
+    int SegmentAt(float time) const;
+
+    const std::string& GetName() const { return name; }
+    int GetRevision() const { return revision; }
+    uint64_t GetHash() const { return hash; }
+    int GetFrameCount() const { return frameCount; }
+    float GetDuration() const { return keys.empty() ? 0.0f : keys.back().Time; }
+    const std::vector<Segment>& GetSegments() const { return segments; }
+
+private:
+    struct Key {
+        float Time;
+        Pose Value;
+    };
+
+    std::string name;
+    int revision = 0;
+    uint64_t hash = 0;
+    int frameCount = 0;
+    std::vector<Key> keys;
+    std::vector<Segment> segments;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef DRONESWARM_H
+#define DRONESWARM_H
+
+#include <glm/glm.hpp>
+#include <random>
+#include <vector>
+
+#include "AABB.h"
+#include "TargetGrid.h"
+#include "TargetPool.h"
+
+// Flocking simulation for drone targets.
+// Runs as a batched kernel over the TargetPool columns. Each frame the drones are
+// counting-sorted into a dense neighbour grid (cell = NeighborRadius), so every
+// neighbour lookup scans contiguous position/velocity runs. Drones read the sorted
+// copy and write into scratch columns, so batches can run on all cores without
+// locking. Results are committed (and the TargetGrid updated) on the calling thread.
+class DroneSwarm {
+public:
+    // Boids weights
+    float SeparationWeight = 1.5f;
+    float AlignmentWeight = 1.0f;
+    float CohesionWeight = 0.8f;
+    float GoalWeight = 0.3f;       // Pull towards the patrol loop
+    float AvoidWeight = 4.0f;      // Push out of building bounds
+
+    float NeighborRadius = 4.0f;
+    float SeparationRadius = 1.5f;
+    int MaxNeighbors = 12;         // Caps the per-drone cost in dense flocks
+    float MinSpeed = 2.0f;
+    float MaxSpeed = 6.0f;
+
+    // Per-frame CPU budget for the kernel, shared by the frame's fixed steps; above it fewer
+    // drones are stepped per frame
+    float BudgetMs = 2.0f;
+
+    glm::vec3 BoundsMin = glm::vec3(-80.0f, 5.0f, -100.0f);
+    glm::vec3 BoundsMax = glm::vec3(-10.0f, 50.0f, -20.0f);
+
+    DroneSwarm();
+
+    // Building bounds to steer around (world space)
+    void SetObstacles(const std::vector<AABB>& boxes);
+    size_t GetObstacleCount() const { return obstacles.size(); }
+
+    // The next `steps` Updates belong to one frame and share its budget (without it, every
+    // Update is a frame of its own)
+    void BeginFrame(int steps);
+    // Advance the drones stored in pool (grid ids are pool slots)
+    void Update(TargetPool& pool, TargetGrid& grid, float deltaTime);
+
+    // A spawn position/velocity inside the bounds, clear of obstacles
+    void RandomDrone(std::mt19937& rng, glm::vec3& outPosition, glm::vec3& outVelocity) const;
+
+    // Stats of the last frame, all its steps (debug panel)
+    float GetLastUpdateMs() const { return lastUpdateMs; }
+    size_t GetLastSteppedCount() const { return lastStepped; }
+    int GetThreadCount() const { return threadCount; }
+
+private:
+    // Obstacles bucketed on a coarse XZ grid (static after SetObstacles)
+    std::vector<AABB> obstacles;
+    std::vector<std::vector<unsigned int>> obstacleBuckets;
+    glm::vec2 obstacleOrigin;
+    float obstacleCellSize;
+    int obstacleCols, obstacleRows;
+
+    // Neighbour grid rebuilt every frame: drones sorted by cell, cellStart[c]..cellStart[c+1]
+    glm::ivec3 neighborDims;
+    glm::vec3 neighborOrigin;
+    float neighborCellSize;
+    std::vector<unsigned int> cellOfDrone;
+    std::vector<unsigned int> cellStart;
+    std::vector<unsigned int> cellFill; // Scatter cursor per cell (scratch, kept for its capacity)
+    std::vector<float> sortedPosX, sortedPosY, sortedPosZ;
+    std::vector<float> sortedVelX, sortedVelY, sortedVelZ;
+
+    // Scratch output columns (dense order, same size as the pool)
+    std::vector<float> nextPosX, nextPosY, nextPosZ;
+    std::vector<float> nextVelX, nextVelY, nextVelZ;
+
+    struct Range { size_t begin, end; };
+    std::vector<Range> windows, tasks; // Per step; kept for their capacity
+
+    float simTime;
+    size_t cursor;          // Round-robin start when the budget does not cover every drone
+    size_t dronesPerFrame;  // Adapted from the measured kernel time, split over the frame's steps
+    int frameSteps;         // Steps of the current frame, and how many of them ran
+    int frameStep;
+    float frameMs;          // Spent so far this frame
+    size_t frameStepped;
+    float lastUpdateMs;
+    size_t lastStepped;
+    int threadCount;
+
+    void BuildNeighborGrid(const TargetPool& pool);
+    glm::ivec3 NeighborCell(const glm::vec3& p) const;
+    void StepRange(const TargetPool& pool, size_t begin, size_t end, float dt);
+    glm::vec3 AvoidObstacles(const glm::vec3& p) const;
+    glm::vec3 PatrolGoal(unsigned int slot) const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+// Picks the render scale of the 3D scene from the measured GPU frame time.
+// GPU cost is assumed to grow with the pixel count (scale^2), so the next scale is
+// the current one times sqrt(target / measured), moving down quickly when over
+// budget and up cautiously when there is headroom. Scales are quantized to Step so
+// the render target pool sees a handful of sizes instead of a new one every frame,
+// and after a change the controller waits for the (smoothed, few frames late) GPU
+// timings to reflect the new size before deciding again.
+class DynamicResolution {
+public:
+    bool Enabled = false;     // Opt-in (debug panel, --dynres headless): native resolution by default
+    float TargetMs = 16.6f;   // GPU frame time to hold
+    float MinScale = 0.5f;    // Per axis, relative to the display size
+    float MaxScale = 1.0f;
+    float Step = 0.05f;       // Quantization of the scale
+    int SettleFrames = 15;    // Frames to wait after a change
+
+    DynamicResolution();
+
+    // Feed the GPU time of the frame just rendered; returns the scale for the next one
+    float Update(float gpuMs);
+
+    // Current scale (1 when disabled)
+    float GetScale() const { return Enabled ? scale : 1.0f; }
+    float GetLastGpuMs() const { return lastGpuMs; }
+    int GetChangeCount() const { return changeCount; }
+
+private:
+    float scale;
+    float lastGpuMs;
+    int framesSinceChange;
+    int changeCount;
+
+    float Quantize(float value) const;
+};
+
+#endif
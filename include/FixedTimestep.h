@@ -0,0 +1,34 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+// Fixed-step simulation clock. Real frame time goes into an accumulator and comes out
+// as whole steps of Step seconds, so the simulation runs the same steps whatever the
+// frame rate; the remainder is the interpolation factor between the last two states.
+// Times are doubles: a float clock loses sub-millisecond precision within hours.
+// At most MaxSteps run per frame: after a stall the game slows down for a moment
+// instead of spending ever longer frames catching up.
+class FixedTimestep {
+public:
+    double Step = 1.0 / 60.0;
+    int MaxSteps = 5;
+
+    // Adds frameSeconds; returns the number of steps to simulate this frame
+    int Advance(double frameSeconds);
+    void Reset();
+
+    // Progress towards the next step in [0, 1): render mix(previous, current, alpha)
+    float GetAlpha() const { return static_cast<float>(accumulator / Step); }
+    double GetSimulatedTime() const { return simulatedTime; }
+    long long GetStepCount() const { return stepCount; }
+    int GetLastSteps() const { return lastSteps; }
+    double GetDroppedTime() const { return droppedTime; } // Seconds discarded by the MaxSteps cap
+
+private:
+    double accumulator = 0.0;
+    double simulatedTime = 0.0;
+    double droppedTime = 0.0;
+    long long stepCount = 0;
+    int lastSteps = 0;
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef FRAMELIMITER_H
+#define FRAMELIMITER_H
+
+#include <glad/glad.h>
+
+#include <chrono>
+
+// Caps the frames the driver may queue ahead of the GPU. Submit puts a fence behind the
+// commands of each frame; Wait, before the next frame is submitted, blocks on the oldest
+// fence while MaxFramesInFlight frames are unfinished. Without it the driver decides how far
+// the CPU runs ahead (often 3 frames), and every queued frame is input latency.
+// Finished frames are retired in Wait: GetCompletedFrame / GetCompletedTime tell when the
+// GPU was seen done with a frame (exact when Wait blocked on it, else up to one frame late).
+// GL thread only; call Release while the context is still current.
+class FrameLimiter {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int MAX_FRAMES_IN_FLIGHT = 4;
+    int MaxFramesInFlight = 2; // 1..MAX_FRAMES_IN_FLIGHT; 0 = no cap (fences only time the frames)
+
+    FrameLimiter();
+
+    // Before the frame's GL work: retires finished frames, waits for a free slot
+    void Wait();
+    // After the frame's GL work (before the swap); returns the frame's number
+    unsigned long long Submit();
+    // Deletes the fences
+    void Release();
+
+    unsigned long long GetCompletedFrame() const { return completedFrame; } // 0 = none yet
+    Clock::time_point GetCompletedTime() const { return completedTime; }
+    int GetFramesInFlight() const { return count; }
+    float GetLastWaitMs() const { return lastWaitMs; }
+
+private:
+    // Uncapped frames still need a bound on the fences kept
+    static const int RING_SIZE = 8;
+
+    struct Fence {
+        GLsync Sync;
+        unsigned long long Frame;
+    };
+
+    Fence fences[RING_SIZE];
+    int oldest;
+    int count;
+    unsigned long long frame;
+    unsigned long long completedFrame;
+    Clock::time_point completedTime;
+    float lastWaitMs;
+
+    void Retire();
+};
+
+#endif
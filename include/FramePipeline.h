@@ -0,0 +1,74 @@
+#ifndef FRAMEPIPELINE_H
+#define FRAMEPIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "InputState.h"
+#include "RenderPacket.h"
+
+// Input of one frame, handed from the GL thread to the game thread
+struct FrameInput {
+    std::vector<InputEvent> Events;
+    float DeltaTime = 0.0f;
+    double Time = 0.0;
+    glm::vec2 LookTotal = glm::vec2(0.0f);            // LookLatch total after Events
+    std::chrono::steady_clock::time_point ClickTime; // First left press in Events (when polled)
+};
+
+// Two-stage frame pipeline. A game thread runs input, simulation, culling and fills a
+// RenderPacket while the GL thread submits the packet of the previous frame; the two
+// packets are swapped once per frame. Costs one frame of latency, saves the shorter of
+// the two stages on a multi-core machine.
+//   const RenderPacket& packet = pipeline.Exchange(std::move(input), [&](const RenderPacket& p) {
+//       ... HUD, debug panel: the game thread is idle here, game state is safe to touch
+//   });
+//   ... submit packet (the game thread is building the next one)
+// With Threaded off the packet is built on the calling thread from this frame's input.
+class FramePipeline {
+public:
+    typedef std::function<void(const FrameInput&, RenderPacket&)> BuildFn;
+    typedef std::function<void(const RenderPacket&)> IdleFn;
+
+    bool Threaded = true;
+
+    FramePipeline();
+    ~FramePipeline();
+
+    // Starts the game thread (idle until the first Exchange)
+    void Start(BuildFn build);
+    void Stop();
+
+    // Hands over this frame's input, returns the packet to submit; valid until the next call.
+    // betweenBuilds runs while no build is in flight.
+    const RenderPacket& Exchange(FrameInput&& input, const IdleFn& betweenBuilds);
+    // Waits for the build in flight, if any
+    void Flush();
+
+    float GetLastBuildMs() const { return lastBuildMs; } // Game thread (or inline) build
+    float GetLastWaitMs() const { return lastWaitMs; }   // GL thread blocked on the build
+
+private:
+    BuildFn build;
+    RenderPacket packets[2];
+    int front;            // Packet the GL thread submits; the game thread writes the other
+    FrameInput work;
+    bool busy;            // A build is queued or running
+    bool pending;         // ...and its packet was not swapped in yet
+    bool quit;
+    float lastBuildMs, lastWaitMs;
+    unsigned long long frame;
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable wake, done;
+
+    void BuildBack(const FrameInput& input);
+    void ThreadLoop();
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef FRAMESTATS_H
+#define FRAMESTATS_H
+
+#include <string>
+#include <vector>
+
+// Frame time distribution of the session, for the stutter an average hides.
+// CPU (frame-to-frame) and GPU times go into fixed 0.1 ms histograms, so
+// percentiles cost nothing per frame and the whole run fits in a few KB.
+// A frame slower than HitchFactor x the recent median is a hitch: a few frames
+// later (once the GPU profiler has read it back) the profiler history of the
+// last seconds is saved under HitchDirectory, at most once per HitchCooldown.
+class FrameStats {
+public:
+    float BudgetMs = 16.6f;      // Frames above this count as over budget
+    float HitchFactor = 2.5f;    // x median
+    float HitchMinMs = 8.0f;     // Never call a frame shorter than this a hitch
+    float HitchCooldown = 5.0f;  // Seconds between captures
+    bool CaptureHitches = true;
+    std::string HitchDirectory = "hitches";
+
+    struct Summary {
+        long long Frames = 0;
+        float P50 = 0.0f, P95 = 0.0f, P99 = 0.0f, Max = 0.0f, Mean = 0.0f;
+        long long OverBudget = 0;
+    };
+
+    struct Hitch {
+        long long Frame;
+        float Ms;
+        float MedianMs;
+        std::string Files;       // Empty when the capture was skipped (cooldown / disabled)
+    };
+
+    FrameStats();
+
+    // Once per frame with the frame-to-frame time
+    void AddCpuFrame(float ms);
+    // GPU time of a frame, whenever the profiler has it (a few frames late)
+    void AddGpuFrame(float ms);
+    void Reset();
+    // The next AddCpuFrame saves a hitch capture (reads the GPU profiler)
+    bool IsCaptureDue() const { return pendingCapture == 0; }
+
+    Summary GetCpuSummary() const { return Summarize(cpu); }
+    Summary GetGpuSummary() const { return Summarize(gpu); }
+    float GetRecentMedianMs() const { return recentMedian; }
+    const std::vector<Hitch>& GetHitches() const { return hitches; }
+
+    // Session summary, percentiles and hitch list
+    bool WriteJson(const std::string& path) const;
+
+    static const int BIN_COUNT = 2500;   // 0.1 ms bins up to 250 ms; slower frames go to the last bin
+    static const int RECENT_FRAMES = 120;
+
+private:
+    struct Histogram {
+        std::vector<unsigned int> Bins;
+        long long Count = 0;
+        double Sum = 0.0;
+        float Max = 0.0f;
+        long long OverBudget = 0;
+    };
+
+    Histogram cpu, gpu;
+    std::vector<float> recent;   // Ring of the last RECENT_FRAMES CPU times
+    std::vector<float> sorted;   // Scratch for the median (keeps its capacity)
+    int recentNext;
+    float recentMedian;
+    int pendingCapture;          // Frames left until the pending hitch is saved, -1 = none
+    size_t captureHitch;         // Index in hitches of the pending one (later hitches do not re-arm)
+    double lastCaptureTime;
+    double elapsed;              // Seconds of recorded frames
+    std::vector<Hitch> hitches;
+
+    void Add(Histogram& h, float ms);
+    Summary Summarize(const Histogram& h) const;
+    void SaveHitchCapture();
+};
+
+#endif
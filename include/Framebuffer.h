@@ -8,12 +8,19 @@ class Framebuffer {
 public:
     unsigned int ID;
     unsigned int TextureID; // Color attachment
-    unsigned int RBO;       // Depth/Stencil attachment
+    unsigned int RBO;       // Depth/Stencil attachment (0 when created without depth)
+    unsigned int DepthTextureID; // Depth/Stencil as a sampleable texture instead of RBO (0 unless requested)
 
     int Width, Height;
     bool IsMultisampled;
-
-    Framebuffer(int width, int height, bool multisampled = false);
+    GLenum InternalFormat;  // Color format, e.g. GL_RGB16F or GL_R11F_G11F_B10F
+    bool HasDepth;
+    int Samples;            // Only used when multisampled
+    bool DepthIsTexture;    // Single-sample targets only (e.g. TAA reprojection reads depth)
+
+    Framebuffer(int width, int height, bool multisampled = false,
+                GLenum internalFormat = GL_RGB16F, bool withDepth = true, int samples = 4,
+                bool depthTexture = false);
     ~Framebuffer();
 
     void Bind();
@@ -25,6 +32,9 @@ public:
 
     void Rescale(int width, int height);
 
+    // Approximate VRAM use of the attachments
+    size_t GetMemoryBytes() const;
+
 private:
     void Init();
 };
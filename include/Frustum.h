@@ -0,0 +1,42 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+#include "AABB.h"
+
+// View frustum as six inward-facing planes, extracted from a view-projection matrix
+// (Gribb/Hartmann). Tests are conservative: a box is rejected only when it lies
+// completely behind one plane.
+struct Frustum {
+    glm::vec4 Planes[6]; // xyz = normal, w = distance; inside when dot(n, p) + w >= 0
+
+    explicit Frustum(const glm::mat4& viewProjection) {
+        const glm::mat4& m = viewProjection;
+        glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+        Planes[0] = row3 + row0; // Left
+        Planes[1] = row3 - row0; // Right
+        Planes[2] = row3 + row1; // Bottom
+        Planes[3] = row3 - row1; // Top
+        Planes[4] = row3 + row2; // Near
+        Planes[5] = row3 - row2; // Far
+        for (glm::vec4& p : Planes)
+            p /= glm::length(glm::vec3(p));
+    }
+
+    bool Intersects(const AABB& box) const {
+        for (const glm::vec4& p : Planes) {
+            // Corner furthest along the normal
+            glm::vec3 corner(p.x >= 0.0f ? box.Max.x : box.Min.x,
+                             p.y >= 0.0f ? box.Max.y : box.Min.y,
+                             p.z >= 0.0f ? box.Max.z : box.Min.z);
+            if (glm::dot(glm::vec3(p), corner) + p.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <glad/glad.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Frame profiler for named, nestable scopes, timed on the CPU and the GPU.
+// GPU times come from GL_TIMESTAMP queries (unlike GL_TIME_ELAPSED they may nest).
+// Each frame records into one of FRAMES_IN_FLIGHT query sets; a set is read back
+// at a later BeginFrame once the GPU has finished it, so nothing ever waits on the
+// GPU. If the GPU is further behind than that, the oldest frame is dropped.
+// GPU timestamps are mapped onto the CPU clock (both sampled at BeginFrame), so
+// the exported trace shows the submission and the GPU execution on one timeline.
+class GpuProfiler {
+public:
+    // One scope of a finished frame (microseconds on the CPU clock)
+    struct Sample {
+        int NameId;
+        int Depth;                  // Nesting level, 0 = top
+        double CpuBeginUs, CpuEndUs;
+        double GpuBeginUs, GpuEndUs;
+    };
+
+    struct FrameRecord {
+        unsigned long long Frame;
+        double CpuBeginUs, CpuEndUs;
+        std::vector<Sample> Samples; // In begin order
+    };
+
+    // Averages of a scope over recent frames (for the debug panel)
+    struct ScopeStats {
+        int NameId;
+        int Depth;
+        float CpuMs, GpuMs;
+    };
+
+    // RAII marker: GpuProfiler::Scope scope("Bloom");
+    class Scope {
+    public:
+        explicit Scope(const std::string& name) { Begin(name); }
+        ~Scope() { End(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Takes effect at the next BeginFrame
+    static bool Enabled;
+
+    static void BeginFrame();
+    static void EndFrame();
+    static void Begin(const std::string& name);
+    static void End();
+
+    // Finished frames, oldest first (up to HISTORY_FRAMES)
+    static const std::deque<FrameRecord>& GetHistory() { return history; }
+    static const std::string& GetName(int nameId) { return names[nameId]; }
+    static int GetDroppedFrames() { return droppedFrames; }
+    // Number of the frame begun last (FrameRecord::Frame of it once it is read back)
+    static unsigned long long GetFrameIndex() { return frameIndex; }
+    // GPU time of a frame: the top-level scopes added up
+    static float GetFrameGpuMs(const FrameRecord& record);
+
+    // Scopes of the latest finished frame, averaged over the last 'frames' frames
+    static void GetAverages(int frames, std::vector<ScopeStats>& out);
+    // Chrome trace (chrome://tracing, Perfetto) of the recorded history: CPU and GPU as two threads
+    static bool ExportChromeTrace(const std::string& path);
+
+    static const int FRAMES_IN_FLIGHT = 4;
+    static const int HISTORY_FRAMES = 240;
+
+private:
+    struct Marker {
+        int NameId;
+        int Depth;
+        int QueryBegin, QueryEnd;   // Indices into the slot's queries
+        double CpuBeginUs, CpuEndUs;
+    };
+
+    struct FrameSlot {
+        bool Pending = false;       // Submitted, waiting for the GPU
+        unsigned long long Frame = 0;
+        double CpuBeginUs = 0.0, CpuEndUs = 0.0;
+        GLint64 GpuReferenceNs = 0; // GL_TIMESTAMP sampled at BeginFrame ...
+        double CpuReferenceUs = 0.0; // ... together with the CPU clock
+        std::vector<Marker> Markers;
+        std::vector<unsigned int> Queries; // Grown on demand, reused
+        size_t QueriesUsed = 0;
+    };
+
+    static FrameSlot slots[FRAMES_IN_FLIGHT];
+    static FrameSlot* current;       // nullptr outside BeginFrame/EndFrame or when disabled
+    static std::vector<int> openMarkers; // -1 for scopes begun while not recording
+    static unsigned long long frameIndex;
+    static std::deque<FrameRecord> history;
+    static std::vector<std::string> names;
+    static int droppedFrames;
+
+    static int Intern(const std::string& name);
+    static int IssueTimestamp(FrameSlot& slot);
+    static bool Collect(FrameSlot& slot);
+    static double NowUs();
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include <glad/glad.h>
+
+// GPU time of a span of GL commands via GL_TIME_ELAPSED queries.
+// Queries rotate through a small ring and are read back a few frames later,
+// so reading the result never stalls the pipeline. Spans must not nest
+// (GL allows one TIME_ELAPSED query at a time).
+class GpuTimer {
+public:
+    GpuTimer();
+    ~GpuTimer();
+
+    void Begin();
+    void End();
+
+    // Latest finished measurement, smoothed (ms); 0 until the first result arrives
+    float GetMs() const { return smoothedMs; }
+
+private:
+    static const int QUERY_COUNT = 4;
+
+    unsigned int queries[QUERY_COUNT];
+    bool pending[QUERY_COUNT];
+    int current;
+    float smoothedMs;
+    bool hasResult;
+
+    void Collect();
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef HEADLESSCONTEXT_H
+#define HEADLESSCONTEXT_H
+
+#include <string>
+
+// OpenGL 3.3 core context without a window or display, for benchmarks on CI machines.
+// Uses EGL: the Mesa surfaceless platform (llvmpipe works without any GPU), then an
+// EGL device (NVIDIA headless), then the default display. No default framebuffer
+// exists, so everything must render into FBOs (see PostProcessor::SetOutputTarget).
+// Only built where CMake finds EGL (CGTP_HAS_EGL); elsewhere Create fails and the
+// caller can fall back to a hidden GLFW window.
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    // Create the context and make it current on this thread
+    bool Create(std::string& error);
+    void Destroy();
+
+    // For gladLoadGLLoader / ShaderCache::Init
+    static void* GetProcAddress(const char* name);
+
+    // "surfaceless", "device" or "default" once created
+    const char* GetPlatformName() const { return platformName; }
+
+private:
+    void* display;
+    void* context;
+    const char* platformName;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef INPUTRECORDER_H
+#define INPUTRECORDER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "InputState.h"
+
+// Records every input event of a session to a compact binary log and plays it back.
+// Events are grouped by frame; each frame ends with the delta time the simulation
+// stepped by, so a replay advances exactly as the recorded session did, independent
+// of how fast the replaying machine renders. The header holds the RNG seed of the
+// session (GameManager::SetSeed).
+//
+// File layout (little endian):
+//   "CGTI" u16 version u32 seed
+//   records: u8 type, u32 microseconds since the previous record, then
+//     KEY / MOUSE_BUTTON: i16 code, u8 action
+//     CURSOR / SCROLL:    f32 x, f32 y
+//     FRAME:              f32 delta time
+//
+// Only input through the GLFW callbacks is recorded; changes made in the ImGui debug
+// panel are not, so leave it alone while recording a session meant for replay.
+class InputRecorder {
+public:
+    static const int FORMAT_VERSION = 1;
+
+    enum Mode { OFF, RECORDING, REPLAYING };
+
+    InputRecorder();
+    ~InputRecorder();
+
+    bool StartRecording(const std::string& path, uint32_t seed, std::string& error);
+    bool StartReplay(const std::string& path, std::string& error);
+    void Stop();
+
+    // Recording: log an event / close the current frame
+    void Record(const InputEvent& e);
+    void EndFrame(float deltaTime);
+
+    // Replay: events and delta time of the next frame; false once the log is exhausted
+    bool NextFrame(std::vector<InputEvent>& outEvents, float& outDeltaTime);
+
+    Mode GetMode() const { return mode; }
+    uint32_t GetSeed() const { return seed; }
+    uint64_t GetFrame() const { return frame; }
+    uint64_t GetFrameCount() const { return frameCount; } // Replay only
+
+private:
+    static const uint8_t FRAME_RECORD = 0xFF;
+
+    Mode mode;
+    uint32_t seed;
+    uint64_t frame;
+    uint64_t frameCount;
+    std::ofstream out;
+    std::vector<unsigned char> replayData;
+    size_t replayOffset;
+    double lastRecordTime;
+    uint64_t eventCount;
+
+    void WriteHeader(uint8_t type);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+#include <cstdint>
+
+// One input event as delivered by a GLFW callback (or read back from a recording)
+struct InputEvent {
+    enum Type : uint8_t {
+        KEY = 0,          // Code = GLFW key, Action = GLFW_PRESS / GLFW_RELEASE / GLFW_REPEAT
+        MOUSE_BUTTON = 1, // Code = GLFW mouse button
+        CURSOR = 2,       // X, Y = cursor position
+        SCROLL = 3,       // X, Y = scroll offsets
+    };
+
+    Type EventType = KEY;
+    int Code = 0;
+    int Action = 0;
+    float X = 0.0f, Y = 0.0f;
+};
+
+// Key / button state built from events instead of polling the window, so gameplay code
+// reads the same state whether the events come from GLFW or from a replay.
+class InputState {
+public:
+    static const int KEY_COUNT = 512;  // > GLFW_KEY_LAST
+    static const int BUTTON_COUNT = 8; // GLFW_MOUSE_BUTTON_LAST + 1
+
+    InputState() { Clear(); }
+
+    void Clear() {
+        for (bool& k : keys) k = false;
+        for (bool& b : buttons) b = false;
+    }
+
+    void Apply(const InputEvent& e) {
+        const bool down = e.Action != 0; // GLFW_RELEASE == 0; PRESS and REPEAT hold the key
+        if (e.EventType == InputEvent::KEY && e.Code >= 0 && e.Code < KEY_COUNT)
+            keys[e.Code] = down;
+        else if (e.EventType == InputEvent::MOUSE_BUTTON && e.Code >= 0 && e.Code < BUTTON_COUNT)
+            buttons[e.Code] = down;
+    }
+
+    bool IsKeyDown(int key) const { return key >= 0 && key < KEY_COUNT && keys[key]; }
+    bool IsMouseButtonDown(int button) const { return button >= 0 && button < BUTTON_COUNT && buttons[button]; }
+
+private:
+    bool keys[KEY_COUNT];
+    bool buttons[BUTTON_COUNT];
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Engine-wide job system: a fixed pool of worker threads, each owning a deque of jobs.
+// A thread pops its own deque from the back (newest, cache-warm) and, when that is
+// empty, steals from the front of the others. Threads that are not workers (main, tools)
+// share deque 0. Jobs are grouped by a Counter; Wait(counter) keeps running jobs on
+// the calling thread until the group is done, so a waiting thread never idles while
+// work is queued and nested waits inside jobs cannot deadlock the pool. With nothing
+// runnable, workers and waiters sleep until a job is queued or a group finishes.
+//   JobSystem::Counter done;
+//   JobSystem::Run([&]() { DecodeTexture(); }, &done);
+//   JobSystem::ParallelFor(count, 256, [&](size_t begin, size_t end) { ... });
+//   JobSystem::Wait(done);
+// Before Init (or after Shutdown) everything runs inline on the calling thread.
+class JobSystem {
+public:
+    // Jobs of a group still running or queued
+    struct Counter {
+        std::atomic<int> Pending{0};
+        bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    struct WorkerStats {
+        std::string Name;
+        float Utilization; // Busy fraction of the wall time since the previous sample
+        long long Jobs;    // Jobs finished since the previous sample
+        long long Steals;  // ...of which taken from another thread's deque
+    };
+
+    // workerCount < 0: one worker per core besides the calling thread. No-op when running.
+    static void Init(int workerCount = -1);
+    static void Shutdown();
+    static bool IsRunning();
+    // Workers + the calling thread (1 when not running)
+    static int GetThreadCount();
+
+    // Queue job. counter (optional) counts it until it finished; the job does not start
+    // before dependency (optional) is done.
+    static void Run(std::function<void()> job, Counter* counter = nullptr, const Counter* dependency = nullptr);
+    // Run queued jobs on this thread until counter is done
+    static void Wait(const Counter& counter);
+    // fn(begin, end) over [0, count) in chunks of at least minChunk; the caller runs the first
+    // chunk and helps with the rest. Returns when every chunk is done.
+    static void ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn);
+
+    // One entry per thread (deque 0 = main) since the previous call; for the debug panel
+    static void SampleStats(std::vector<WorkerStats>& out);
+};
+
+#endif
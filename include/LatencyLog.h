@@ -0,0 +1,56 @@
+#ifndef LATENCYLOG_H
+#define LATENCYLOG_H
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <string>
+
+// A click handled by GameManager::CheckShot in a frame (copied along with the frame)
+struct ClickTiming {
+    bool Valid = false;
+    bool Hit = false;
+    std::chrono::steady_clock::time_point Input; // Press polled (GLFW gives no OS event time)
+    std::chrono::steady_clock::time_point Shot;  // CheckShot ran (game thread)
+};
+
+// Click-to-photon instrumentation (--latency-log FILE): one CSV line per click CheckShot
+// handled, input -> CheckShot -> frame submitted -> frame finished on the GPU. GL has no
+// present timestamp; the finished fence (FrameLimiter) is the closest it gets: the swap is
+// queued right behind it, and vsync adds up to one refresh interval on top.
+// Call from the thread that submits the frames.
+class LatencyLog {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    LatencyLog();
+
+    bool Open(const std::string& path, std::string& error);
+    void Close();
+    bool IsOpen() const { return file.is_open(); }
+
+    // Frame number (FrameLimiter::Submit) of a submitted frame that handled a click
+    void AddClick(const ClickTiming& click, unsigned long long frame, Clock::time_point submitted);
+    // Frames up to and including `frame` finished at `time`: writes their clicks
+    void Complete(unsigned long long frame, Clock::time_point time);
+
+    int GetClickCount() const { return clicks; }
+    float GetLastMs() const { return lastMs; }   // Input -> GPU done of the last click
+    float GetAverageMs() const { return clicks ? static_cast<float>(sumMs / clicks) : 0.0f; }
+
+private:
+    struct Pending {
+        ClickTiming Click;
+        unsigned long long Frame;
+        Clock::time_point Submitted;
+    };
+
+    std::ofstream file;
+    std::deque<Pending> pending;
+    Clock::time_point start;
+    int clicks;
+    double sumMs;
+    float lastMs;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef LOOKLATCH_H
+#define LOOKLATCH_H
+
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "InputState.h"
+
+// Late latching of the camera orientation. Every polled cursor event goes through Track,
+// which sums the same offsets the mouse look applies; a frame remembers the total its camera
+// already contains (FrameInput / RenderPacket::LookTotal). Right before the frame is
+// submitted, Apply turns a copy of that camera by the look input polled since, so the view
+// follows the mouse as of the last poll rather than as of the frame the game thread built.
+// Only the view is latched: position, culling, HUD and shots stay as built. The turn is capped
+// at MAX_DEGREES; culling widens the field of view by CULL_MARGIN_DEGREES to cover it.
+// Main thread only.
+class LookLatch {
+public:
+    static constexpr float MAX_DEGREES = 5.0f;
+    static constexpr float CULL_MARGIN_DEGREES = 2.0f * MAX_DEGREES;
+
+    bool Enabled = true;
+
+    void Track(const InputEvent& e);
+    glm::vec2 GetTotal() const { return total; }
+
+    // eye turned by the look input after the total `since`
+    Camera Apply(const Camera& eye, const glm::vec2& since) const;
+
+private:
+    glm::vec2 total = glm::vec2(0.0f);
+    glm::vec2 last = glm::vec2(0.0f);
+    bool hasLast = false;
+};
+
+#endif
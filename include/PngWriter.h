@@ -0,0 +1,14 @@
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#include <string>
+
+// Minimal PNG encoder for frame dumps: 8-bit gray / RGB / RGBA, zlib "stored" blocks
+// (no compression, so no dependency and no CPU time spent on it; files are raw size).
+class PngWriter {
+public:
+    // pixels: rows of width * channels bytes; flipY for glReadPixels output (bottom row first)
+    static bool Write(const std::string& path, int width, int height, int channels, const unsigned char* pixels, bool flipY = false);
+};
+
+#endif
@@ -3,39 +3,154 @@
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <functional>
+#include <string>
+#include <unordered_map>
 
 #include "Shader.h"
 #include "Framebuffer.h"
+#include "RenderTargetPool.h"
+#include "RenderGraph.h"
+#include "BloomRenderer.h"
+#include "DynamicResolution.h"
+
+// Bloom implementations (the Gaussian one is kept for comparison)
+enum Bloom_Mode {
+    BLOOM_GAUSSIAN,  // Bright extract + 10 full-resolution 9-tap blur passes
+    BLOOM_MIPCHAIN   // Downsample/upsample over half-size targets
+};
+
+// Feature bits of the uber post shader (shaders/post.fs); each set is its own compiled variant
+enum Post_Feature {
+    POST_BLOOM    = 1 << 0,
+    POST_GLITCH   = 1 << 1,
+    POST_RAIN     = 1 << 2,
+    POST_TONEMAP  = 1 << 3,
+    POST_VIGNETTE = 1 << 4,
+    POST_UPSCALE  = 1 << 5   // Catmull-Rom sampling of the scene (set while rendering below display size)
+};
+
+// Anti-aliasing modes; each one is a different shape of the render graph
+enum AA_Mode {
+    AA_OFF,
+    AA_MSAA2,   // Multisampled scene target, resolved by the graph before post
+    AA_MSAA4,
+    AA_MSAA8,   // Clamped to GL_MAX_SAMPLES
+    AA_FXAA,    // One pass over the final tone-mapped image
+    AA_SMAA,    // SMAA 1x: edge detection -> blending weights -> neighbourhood blend
+    AA_TAA,     // Jittered projection + reprojected history on the HDR scene
+    AA_TAAU,    // TAA that also upscales: scene at TAAUScale, history at display size
+    AA_MODE_COUNT
+};
 
 class PostProcessor {
 public:
-    Shader* ScreenShader;
-    Shader* GlitchShader;
     Shader* BlurShader; // [NEW]
     Shader* BloomExtractShader; // [NEW]
     
-    unsigned int Width, Height;
+    unsigned int Width, Height; // Display size (post output)
 
     bool UseGlitch;
+    bool UseRain = true;
+    bool UseTonemap = true;
+    bool UseVignette = false;
     bool UseBloom = false; // [NEW]
+    Bloom_Mode BloomMode = BLOOM_MIPCHAIN;
+    float BloomIntensity = 1.0f;
+    float Exposure = 1.0f;
+    float VignetteStrength = 0.5f;
+    bool BicubicUpscale = true;  // Otherwise bilinear when the scene is rendered below display size
+
+    AA_Mode AAMode = AA_MSAA4;
+    float SMAAThreshold = 0.1f;  // Luma difference that counts as an edge
+    float TAAFeedback = 0.9f;    // History weight
+    float TAAUScale = 0.67f;     // TAAU render scale (0.5 - 0.77); dynamic resolution may go lower, never higher
+
+    // Cost of an AA mode, as last measured while it was active
+    struct AAStats {
+        bool Measured = false;
+        size_t TargetBytes = 0;  // Peak render target memory of the frame (+ TAA history)
+        float FrameGpuMs = 0.0f; // All passes
+        float AAGpuMs = 0.0f;    // Passes that only exist for AA (resolve / FXAA / SMAA / TAA)
+    };
     
     // Constructor requires paths for shaders, or assumes default locations
     PostProcessor(unsigned int width, unsigned int height);
     ~PostProcessor();
 
-    // 1. Prepare for scene rendering (Bind MSAA FBO)
-    void BeginRender(); 
-    
-    // 2. Resolve MSAA and Render Quad to Screen with effects
-    void EndRender(float time);
+    // Build and run the frame graph: Scene (drawScene into the scene target) -> [TAA] -> Bloom -> Composite -> [FXAA/SMAA].
+    // Scene, TAA and bloom run at the dynamic render size; the composite upscales to the display size.
+    // Applies a pending resize first. Passes whose output is unused this frame are culled.
+    void Render(float time, const std::function<void()>& drawScene);
 
+    // TAA: sub-pixel offset (NDC) to add to this frame's projection, zero in other modes.
+    // Call before Render, together with SetViewProjection (the unjittered matrices).
+    glm::vec2 GetProjectionJitter() const;
+    void SetViewProjection(const glm::mat4& viewProjection) { ViewProjection = viewProjection; }
+
+    static const char* GetAAModeName(AA_Mode mode);
+
+    DynamicResolution* GetDynamicResolution() { return DynRes; }
+    // Size the scene is rendered at this frame (display size times the dynamic scale)
+    int GetRenderWidth() const { return RenderWidth; }
+    int GetRenderHeight() const { return RenderHeight; }
+    const AAStats& GetAAStats(AA_Mode mode) const { return AAMeasured[mode]; }
+    int GetMaxSamples() const { return MaxSamples; }
+
+    // Final output goes to target instead of the default framebuffer (nullptr = back to it).
+    // Used by the headless mode, which has no window; target must be Width x Height.
+    void SetOutputTarget(Framebuffer* target) { OutputTarget = target; }
+
+    // Only records the size; window drags fire many events, the last one wins at the next Render
     void UpdateSize(int width, int height);
 
+    RenderTargetPool* GetTargetPool() { return Targets; }
+    const RenderGraph* GetRenderGraph() const { return Graph; }
+
+    BloomRenderer* GetBloomRenderer() { return Bloom; }
+    // GPU time of the bloom passes per mode (last measured, ms)
+    float GetBloomGpuMs(Bloom_Mode mode) const;
+
+    // Post_Feature bits selected by the Use* toggles
+    unsigned int GetFeatureMask() const;
+    // Start compiling a variant ahead of time (e.g. at startup for the default toggles)
+    void PrecompileVariant(unsigned int features) { GetPostShader(features); }
+    size_t GetVariantCount() const { return PostVariants.size(); }
+
 private:
     unsigned int VAO, VBO;
-    Framebuffer* MSAAFBO;
-    Framebuffer* IntermediateFBO;
-    Framebuffer* PingPongFBO[2]; // [NEW]
+    RenderTargetPool* Targets;
+    RenderGraph* Graph;
+    int PendingWidth, PendingHeight;
+    DynamicResolution* DynRes;
+    int RenderWidth, RenderHeight;
+    BloomRenderer* Bloom;
+    Framebuffer* OutputTarget;    // Not owned
+    std::unordered_map<unsigned int, Shader*> PostVariants; // Keyed by feature mask, compiled on first use
+    Shader* ActivePost;           // Last variant drawn with; kept while a newly toggled one compiles
+    unsigned int ActiveFeatures;
+
+    // AA
+    Shader* FXAAShader;
+    Shader* SMAAEdgeShader;
+    Shader* SMAAWeightShader;
+    Shader* SMAABlendShader;
+    Shader* TAAShader;
+    Shader* TAAUShader;           // taa.fs with TAA_UPSAMPLE
+    int MaxSamples;
+    Framebuffer* History[2];      // TAA/TAAU ping-pong, persistent (imported into the graph)
+    int HistoryIndex;             // History[HistoryIndex] is written this frame
+    bool HistoryValid;
+    glm::mat4 ViewProjection, PrevViewProjection;
+    unsigned long long FrameIndex; // Drives the jitter sequence
+    AAStats AAMeasured[AA_MODE_COUNT];
+
+    void RenderGaussianBloom(unsigned int sourceTexture, Framebuffer* output);
+    void Composite(float time, unsigned int sceneTexture, unsigned int bloomTexture, float bloomStrength);
+    Shader* GetPostShader(unsigned int features);
+    void UpdateHistoryTargets();
+    void ComputeRenderSize(int& width, int& height) const;
+    float GetAAPassGpuMs() const;
 
     void InitRenderData();
 };
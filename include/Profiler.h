@@ -0,0 +1,99 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// CPU scope profiler.
+//   CGTP_PROFILE_SCOPE("Assimp Import");   // until the end of the enclosing block
+//   CGTP_PROFILE_FUNCTION();               // named after the function
+//   CGTP_PROFILE_THREAD("Drone Worker");   // label the calling thread in captures
+// Each scope writes one event (name, begin/end TSC ticks, depth) into a ring buffer
+// owned by the calling thread: no locks and no allocation on the hot path. A capture
+// copies the rings and writes them as Chrome trace JSON (chrome://tracing, Perfetto).
+// Without CGTP_ENABLE_PROFILER (CMake option, on in Debug) the macros expand to
+// nothing; Profiler::SaveCapture then only reports that it was compiled out.
+class Profiler {
+public:
+    static const bool CompiledIn;
+
+    // Write everything still in the rings (the last EVENTS_PER_THREAD scopes of every thread)
+    static bool SaveCapture(const std::string& path);
+
+#if defined(CGTP_ENABLE_PROFILER)
+    static const uint32_t EVENTS_PER_THREAD = 1u << 16;
+
+    struct Event {
+        const char* Name;   // String literal / __func__, never freed
+        uint64_t Begin, End;
+        uint32_t Depth;
+    };
+
+    // One per live thread. Threads that exit hand their buffer to the next new thread,
+    // so threads that come and go (job workers across JobSystem::Init / Shutdown, the game and
+    // render threads) keep a bounded number of rings and their history.
+    struct ThreadBuffer {
+        std::atomic<uint64_t> Head{0};  // Events written so far; slot = Head % EVENTS_PER_THREAD
+        Event Events[EVENTS_PER_THREAD];
+        uint32_t Depth = 0;
+        uint32_t Lane = 0;              // tid in the trace
+        char Name[32] = {};
+    };
+
+    static void SetThreadName(const char* name);
+
+    static ThreadBuffer* LocalBuffer() {
+        ThreadBuffer* buffer = localBuffer;
+        return buffer ? buffer : AcquireBuffer();
+    }
+
+    static uint64_t Ticks();
+
+    class ScopeMarker {
+    public:
+        explicit ScopeMarker(const char* name) : buffer(LocalBuffer()), name(name) {
+            depth = buffer->Depth++;
+            begin = Ticks();
+        }
+        ~ScopeMarker() {
+            uint64_t end = Ticks();
+            buffer->Depth--;
+            // Single writer: fill the slot, then publish it
+            uint64_t head = buffer->Head.load(std::memory_order_relaxed);
+            Event& e = buffer->Events[head & (EVENTS_PER_THREAD - 1)];
+            e.Name = name;
+            e.Begin = begin;
+            e.End = end;
+            e.Depth = depth;
+            buffer->Head.store(head + 1, std::memory_order_release);
+        }
+        ScopeMarker(const ScopeMarker&) = delete;
+        ScopeMarker& operator=(const ScopeMarker&) = delete;
+
+    private:
+        ThreadBuffer* buffer;
+        const char* name;
+        uint64_t begin;
+        uint32_t depth;
+    };
+
+private:
+    static thread_local ThreadBuffer* localBuffer;
+    static ThreadBuffer* AcquireBuffer();
+#endif
+};
+
+#if defined(CGTP_ENABLE_PROFILER)
+#define CGTP_PROFILE_CONCAT_INNER(a, b) a##b
+#define CGTP_PROFILE_CONCAT(a, b) CGTP_PROFILE_CONCAT_INNER(a, b)
+#define CGTP_PROFILE_SCOPE(name) Profiler::ScopeMarker CGTP_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define CGTP_PROFILE_FUNCTION() CGTP_PROFILE_SCOPE(__func__)
+#define CGTP_PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define CGTP_PROFILE_SCOPE(name) ((void)0)
+#define CGTP_PROFILE_FUNCTION() ((void)0)
+#define CGTP_PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef RENDERCOMMANDS_H
+#define RENDERCOMMANDS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Shader;
+
+// Recorded GL commands of a scene pass. Scene code (Mesh::Draw, TargetRenderer, the scene lambda
+// in main) records into it without touching GL; the thread that owns the context replays the list
+// later. Commands are packed back to back into one byte buffer that keeps its capacity across
+// Clear, so a steady frame records without allocating. Uniform names and uploads are copied in:
+// the recording thread may change its data as soon as the call returns.
+//   RenderCommandBuffer& cmd = frame.Commands;          // game side
+//   cmd.UseShader(shader);
+//   cmd.SetMat4(shader, "model", model);
+//   cmd.BindVertexArray(vao);
+//   cmd.DrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT);
+//   ...
+//   frame.Commands.Replay();                             // render thread, context current
+// An immediate buffer runs every command as it is recorded instead (no copy), for code that
+// draws on the GL thread directly.
+class RenderCommandBuffer {
+public:
+    // Added to every SetProjection on execution (TAA jitter, only known on the render thread)
+    glm::vec2 ProjectionJitter = glm::vec2(0.0f);
+
+    explicit RenderCommandBuffer(bool immediate = false);
+
+    // Shared immediate buffer (no jitter), for callers on the GL thread that pass no buffer
+    static RenderCommandBuffer& Immediate();
+
+    bool IsImmediate() const { return immediate; }
+
+    // Commands. The shader must outlive the replay; uniforms go to its program by name.
+    void UseShader(Shader& shader);
+    void SetInt(const Shader& shader, const std::string& name, int value);
+    void SetFloat(const Shader& shader, const std::string& name, float value);
+    void SetVec3(const Shader& shader, const std::string& name, const glm::vec3& value);
+    void SetMat4(const Shader& shader, const std::string& name, const glm::mat4& value);
+    // A projection matrix without jitter; ProjectionJitter is applied when it executes
+    void SetProjection(const Shader& shader, const std::string& name, const glm::mat4& projection);
+    void ActiveTexture(unsigned int unit);
+    void BindTexture(unsigned int texture); // GL_TEXTURE_2D on the active unit
+    void BindVertexArray(unsigned int vao);
+    void DrawElements(GLenum mode, GLsizei count, GLenum type); // From the bound element buffer
+    void DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances);
+    // Orphan buffer, then upload bytes of data (copied)
+    void BufferData(GLenum target, unsigned int buffer, const void* data, size_t bytes, GLenum usage);
+
+    // Execute the recorded commands in order (context current); the list is kept
+    void Replay();
+    // Drop the commands, keep the memory
+    void Clear();
+
+    size_t GetCommandCount() const { return commandCount; }
+    size_t GetByteSize() const { return bytes.size(); }
+
+private:
+    bool immediate;
+    std::vector<unsigned char> bytes;
+    size_t commandCount;
+
+    void Emit(unsigned short type, const void* fixed, size_t fixedSize, const void* tail, size_t tailSize);
+    void Execute(unsigned short type, const unsigned char* fixed, const unsigned char* tail, size_t tailSize);
+};
+
+#endif
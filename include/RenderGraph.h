@@ -0,0 +1,117 @@
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "RenderTargetPool.h"
+#include "GpuTimer.h"
+
+// Per-frame graph of render passes.
+// Every frame the passes are declared again with the targets they read and write;
+// Compile() then
+//   - inserts a resolve (blit to a single-sample copy) before any pass that samples
+//     a multisampled target,
+//   - culls every pass whose outputs nobody reads (walking back from the outputs),
+//   - computes first/last use of each transient target,
+// and Execute() runs the surviving passes in declaration order, acquiring targets
+// from the pool right before their first use and releasing them after their last,
+// so targets with disjoint lifetimes share memory. Each pass is GPU-timed.
+class RenderGraph {
+public:
+    typedef int Resource; // Handle of a declared target, -1 = none
+
+    class PassContext;
+    typedef std::function<void(PassContext&)> ExecuteFn;
+
+    // Declares what a pass touches (returned by AddPass)
+    class PassBuilder {
+    public:
+        PassBuilder& Read(Resource resource);   // Sampled as a texture
+        PassBuilder& Write(Resource resource);  // Rendered into
+    private:
+        friend class RenderGraph;
+        PassBuilder(RenderGraph* graph, int pass) : graph(graph), pass(pass) {}
+        RenderGraph* graph;
+        int pass;
+    };
+
+    // Handed to a pass while it executes
+    class PassContext {
+    public:
+        // The physical target of a resource (nullptr for the backbuffer)
+        Framebuffer* GetTarget(Resource resource) const;
+        // Texture to sample for a read (the resolved copy for multisampled targets)
+        unsigned int GetTexture(Resource resource) const;
+        // Bind a written resource as the render target and set the viewport
+        void BindTarget(Resource resource) const;
+        RenderTargetPool& GetPool() const { return graph->pool; }
+    private:
+        friend class RenderGraph;
+        PassContext(RenderGraph* graph, int pass) : graph(graph), pass(pass) {}
+        RenderGraph* graph;
+        int pass;
+    };
+
+    explicit RenderGraph(RenderTargetPool& pool);
+    ~RenderGraph();
+
+    // Forget last frame's declarations (timings are kept)
+    void Reset();
+
+    Resource CreateTarget(const std::string& name, const RenderTargetDesc& desc);
+    // The default framebuffer; always an output
+    Resource ImportBackbuffer(const std::string& name, int width, int height);
+    // A target owned outside the graph that outlives the frame (e.g. a history buffer); not pooled
+    Resource ImportTarget(const std::string& name, Framebuffer* target);
+    // Passes writing an output are never culled
+    void MarkOutput(Resource resource);
+
+    PassBuilder AddPass(const std::string& name, ExecuteFn execute);
+
+    void Compile();
+    void Execute();
+
+    // Human-readable schedule: passes (culled ones marked), reads/writes, lifetimes, timings
+    std::string Dump() const;
+    // Smoothed GPU time of the last run of a pass by name (0 if never run)
+    float GetPassGpuMs(const std::string& name) const;
+    // Sum of the above over the passes that ran this frame
+    float GetFrameGpuMs() const;
+    int GetCulledCount() const { return culledCount; }
+
+private:
+    struct ResourceNode {
+        std::string Name;
+        RenderTargetDesc Desc;
+        bool Imported;        // Backbuffer or ImportTarget: not pooled
+        bool Output;
+        int FirstUse, LastUse; // Schedule indices, -1 if unused
+        Framebuffer* Target;   // Valid between FirstUse and LastUse during Execute (always for imports, nullptr = backbuffer)
+    };
+
+    struct PassNode {
+        std::string Name;
+        ExecuteFn Execute;
+        std::vector<Resource> Reads, Writes;
+        // Reads of multisampled targets point at the resolved copy: (declared, actual)
+        std::vector<std::pair<Resource, Resource>> Redirects;
+        bool Culled;
+    };
+
+    RenderTargetPool& pool;
+    std::vector<ResourceNode> resources;
+    std::vector<PassNode> passes;   // Declaration order, resolves inserted by Compile
+    std::map<std::string, GpuTimer*> timers;
+    int culledCount;
+    bool compiled;
+
+    void InsertResolves();
+    void CullPasses();
+    void ComputeLifetimes();
+    Resource Actual(int pass, Resource resource) const;
+};
+
+#endif
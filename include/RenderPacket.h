@@ -0,0 +1,45 @@
+#ifndef RENDERPACKET_H
+#define RENDERPACKET_H
+
+#include <vector>
+
+#include "Camera.h"
+#include "LatencyLog.h"
+
+// Everything the GL thread needs to draw one frame, copied out of the game state by the
+// game thread. The GL thread reads only the packet while the game thread already writes
+// the next one (see FramePipeline), so nothing in here may point into live game state.
+struct RenderPacket {
+    unsigned long long Frame = 0; // Packets built so far, this one included
+
+    // View: Eye.Position is already interpolated between the last two steps; the GL thread
+    // adds the TAA jitter when it builds the matrices
+    Camera Eye;
+    glm::vec2 LookTotal = glm::vec2(0.0f); // Look input Eye already contains (LookLatch)
+    float Alpha = 1.0f;
+    float Time = 0.0f;            // Shader animation time
+
+    // City meshes inside the frustum (when Culled; otherwise the GL thread draws all)
+    bool Culled = false;
+    std::vector<unsigned int> VisibleMeshes;
+    // Target instance offsets, xyz per target, interpolated
+    std::vector<float> TargetOffsets;
+
+    // HUD
+    bool GameOver = false;
+    int Score = 0;
+    float TimeLeft = 0.0f;
+    int SignalsInView = 0;
+    bool TargetLocked = false;
+
+    // Click handled by CheckShot while building this packet (latency instrumentation)
+    ClickTiming Click;
+
+    // Window requests: GLFW window calls belong to the GL (main) thread
+    bool CursorVisible = false;
+    bool CloseRequested = false;
+
+    int Steps = 0;                // Simulation steps run for this packet
+};
+
+#endif
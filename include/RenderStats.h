@@ -0,0 +1,54 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <atomic>
+
+// Per-frame draw counters, bumped next to every draw call. Scene draws are counted where they
+// are recorded (main thread), post-processing passes where they run (the render thread with
+// --render-thread), so the counters are atomic. BeginFrame (main thread) moves the running
+// counts to GetLastFrame and starts from zero.
+class RenderStats {
+public:
+    struct Counters {
+        int DrawCalls = 0;
+        long long Triangles = 0;  // Instances included
+        int MeshesTested = 0;     // Frustum tests
+        int MeshesCulled = 0;
+    };
+
+    static void BeginFrame() {
+        last.DrawCalls = drawCalls.exchange(0, std::memory_order_relaxed);
+        last.Triangles = triangles.exchange(0, std::memory_order_relaxed);
+        last.MeshesTested = meshesTested.exchange(0, std::memory_order_relaxed);
+        last.MeshesCulled = meshesCulled.exchange(0, std::memory_order_relaxed);
+    }
+
+    static void AddDraw(long long triangleCount, int instances = 1) {
+        drawCalls.fetch_add(1, std::memory_order_relaxed);
+        triangles.fetch_add(triangleCount * instances, std::memory_order_relaxed);
+    }
+
+    static void AddCullTest(bool culled) {
+        meshesTested.fetch_add(1, std::memory_order_relaxed);
+        if (culled) meshesCulled.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static Counters GetCurrent() {
+        Counters c;
+        c.DrawCalls = drawCalls.load(std::memory_order_relaxed);
+        c.Triangles = triangles.load(std::memory_order_relaxed);
+        c.MeshesTested = meshesTested.load(std::memory_order_relaxed);
+        c.MeshesCulled = meshesCulled.load(std::memory_order_relaxed);
+        return c;
+    }
+    static const Counters& GetLastFrame() { return last; }
+
+private:
+    static std::atomic<int> drawCalls;
+    static std::atomic<long long> triangles;
+    static std::atomic<int> meshesTested;
+    static std::atomic<int> meshesCulled;
+    static Counters last;
+};
+
+#endif
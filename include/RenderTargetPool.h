@@ -0,0 +1,66 @@
+#ifndef RENDERTARGETPOOL_H
+#define RENDERTARGETPOOL_H
+
+#include <glad/glad.h>
+#include <vector>
+
+#include "Framebuffer.h"
+
+// What a pass needs from a render target; targets with equal descs are interchangeable
+struct RenderTargetDesc {
+    int Width = 0, Height = 0;
+    GLenum Format = GL_RGB16F;
+    int Samples = 1;      // > 1 = multisampled
+    bool Depth = false;   // Depth/stencil renderbuffer
+    bool DepthTexture = false; // With Depth: store it as a texture passes can sample (single-sample only)
+
+    bool operator==(const RenderTargetDesc& o) const {
+        return Width == o.Width && Height == o.Height && Format == o.Format && Samples == o.Samples && Depth == o.Depth
+            && DepthTexture == o.DepthTexture;
+    }
+};
+
+// Pool of transient framebuffers.
+// Passes Acquire a target for as long as they need it and Release it afterwards;
+// a later pass asking for the same desc gets the released one back, so passes that
+// do not overlap share memory. Targets nobody asked for in a while (e.g. the old
+// size after a resize) are destroyed by EndFrame.
+class RenderTargetPool {
+public:
+    explicit RenderTargetPool(int maxIdleFrames = 3);
+    ~RenderTargetPool();
+
+    Framebuffer* Acquire(const RenderTargetDesc& desc);
+    void Release(Framebuffer* target);
+
+    // Frame boundaries: EndFrame trims targets idle for more than maxIdleFrames
+    void BeginFrame();
+    void EndFrame();
+    void Clear();
+
+    // Stats (debug panel)
+    size_t GetTargetCount() const { return entries.size(); }
+    size_t GetInUseCount() const;
+    size_t GetMemoryBytes() const;
+    int GetCreatedThisFrame() const { return createdThisFrame; }
+    // Most memory held by acquired targets at once since BeginFrame (the frame's real footprint)
+    size_t GetPeakInUseBytes() const { return peakInUseBytes; }
+
+private:
+    struct Entry {
+        RenderTargetDesc Desc;
+        Framebuffer* Target;
+        bool InUse;
+        unsigned long long LastUsedFrame;
+    };
+
+    std::vector<Entry> entries;
+    unsigned long long frameIndex;
+    int maxIdleFrames;
+    int createdThisFrame;
+    size_t inUseBytes, peakInUseBytes;
+
+    void TrackAcquire(Framebuffer* target);
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <glm/glm.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "imgui.h"
+#include "RenderCommands.h"
+#include "LatencyLog.h"
+
+struct GLFWwindow;
+
+// One frame for the render thread: the recorded scene pass, a copy of the UI and the few values
+// the frame graph needs. Recorded on the main thread, executed on the render thread; nothing in
+// here points into state the main thread keeps changing.
+struct RenderFrame {
+    bool Scene = false;                          // Frame graph + scene; otherwise clear + UI (menus)
+    RenderCommandBuffer Commands;
+    float Time = 0.0f;                           // Shader animation time
+    glm::mat4 ViewProjection = glm::mat4(1.0f);  // Unjittered, for TAA reprojection
+    int FramebufferWidth = 0, FramebufferHeight = 0;
+    ClickTiming Click;                           // For the latency log, once the frame is submitted
+
+    RenderFrame() = default;
+    RenderFrame(const RenderFrame&) = delete;
+    RenderFrame& operator=(const RenderFrame&) = delete;
+    ~RenderFrame();
+
+    // Copies the draw lists: ImGui reuses its own as soon as the next frame starts
+    void SetUi(const ImDrawData* drawData);
+    ImDrawData* GetUi() { return ui.Valid ? &ui : nullptr; }
+    void Reset();
+
+private:
+    ImDrawData ui;
+    void ClearUi();
+};
+
+// Dedicated render thread: owns the window's GL context and executes recorded frames, so the
+// main thread (input, UI, recording) never blocks on the driver or on the swap.
+//   renderThread.Start(window, [&](RenderFrame& frame) { ... GL ... });
+//   RenderFrame& frame = renderThread.BeginFrame();  // waits for a free slot
+//   ... record frame.Commands, frame.SetUi(...)
+//   renderThread.SubmitFrame();
+// The main thread runs at most FRAME_SLOTS frames ahead. The execute callback runs with the
+// state lock held; take it (GetStateLock) to change anything the callback reads.
+class RenderThread {
+public:
+    static const int FRAME_SLOTS = 2;
+    typedef std::function<void(RenderFrame&)> ExecuteFn;
+
+    RenderThread();
+    ~RenderThread();
+
+    // Releases the context on the calling thread and makes it current on the render thread
+    void Start(GLFWwindow* window, ExecuteFn execute);
+    // Executes the submitted frames, then makes the context current on the calling thread again
+    void Stop();
+    bool IsRunning() const { return thread.joinable(); }
+
+    // Slot for the next frame, cleared; blocks while FRAME_SLOTS frames are queued
+    RenderFrame& BeginFrame();
+    void SubmitFrame();
+
+    std::mutex& GetStateLock() { return stateLock; }
+
+    float GetLastWaitMs() const { return lastWaitMs; } // Main thread blocked in BeginFrame
+    // Last executed frame; read with the state lock held
+    float GetLastExecuteMs() const { return lastExecuteMs; }
+    size_t GetLastCommandCount() const { return lastCommands; }
+    size_t GetLastCommandBytes() const { return lastCommandBytes; }
+
+private:
+    GLFWwindow* window;
+    ExecuteFn execute;
+    RenderFrame frames[FRAME_SLOTS];
+    int head;             // Oldest queued frame
+    int queued;           // Submitted, not yet swapped
+    bool quit;
+    float lastWaitMs;
+    float lastExecuteMs;
+    size_t lastCommands, lastCommandBytes;
+
+    std::thread thread;
+    std::mutex lock;
+    std::mutex stateLock;
+    std::condition_variable wake, freed;
+
+    void ThreadLoop();
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SHADERCACHE_H
+#define SHADERCACHE_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+// On-disk cache of linked program binaries, plus parallel compilation.
+// glad only loads GL 3.3 core, so the two extensions used here are loaded by hand:
+//   ARB_get_program_binary       glGetProgramBinary / glProgramBinary (core in 4.1)
+//   KHR_parallel_shader_compile  compile/link on driver threads, poll GL_COMPLETION_STATUS_KHR
+// Without them Shader falls back to plain compilation. Binaries are keyed by a hash of
+// the final sources (defines included) and the driver strings, so a driver update or an
+// edited shader simply misses the cache; a binary the driver rejects is recompiled.
+class ShaderCache {
+public:
+    // Call once after the GL context is current. loader is the same proc loader given to glad.
+    static void Init(GLADloadproc loader, const std::string& directory = "shader_cache");
+
+    static bool HasProgramBinary() { return programBinarySupported; }
+    static bool HasParallelCompile() { return parallelCompileSupported; }
+
+    // Key for a vertex/fragment source pair on the current driver
+    static uint64_t Key(const std::string& vertexCode, const std::string& fragmentCode);
+
+    // Try to load program from the cache; true if it linked
+    static bool Load(uint64_t key, unsigned int program);
+    // Write a linked program (created with Prepare) to the cache
+    static void Store(uint64_t key, unsigned int program);
+    // Set up a new program before linking so its binary can be retrieved later
+    static void Prepare(unsigned int program);
+    // Non-blocking: has the driver finished compiling/linking this object?
+    static bool IsCompileFinished(unsigned int object, bool isProgram);
+
+    static int GetHits() { return hits; }
+    static int GetMisses() { return misses; }
+
+private:
+    static bool programBinarySupported;
+    static bool parallelCompileSupported;
+    static std::string cacheDirectory;
+    static uint64_t driverHash;
+    static int hits, misses;
+
+    static std::string PathFor(uint64_t key);
+};
+
+#endif
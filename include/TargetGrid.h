@@ -0,0 +1,78 @@
+#ifndef TARGETGRID_H
+#define TARGETGRID_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Hashed uniform grid over the city for target lookups.
+// Items are small spheres of a fixed radius, identified by a caller-chosen id
+// (usually a slot index). Each item is linked into every cell its bounding box
+// touches (at most 8, because cellSize >= 2 * radius), so a ray only has to walk
+// the cells it passes through. Insert / Remove / Move are O(1).
+class TargetGrid {
+public:
+    TargetGrid(float cellSize = 8.0f, float itemRadius = 0.8f);
+
+    void Insert(unsigned int id, const glm::vec3& position);
+    void Remove(unsigned int id);
+    void Move(unsigned int id, const glm::vec3& position);
+    void Clear();
+
+    bool Contains(unsigned int id) const;
+    size_t Size() const { return count; }
+    size_t CellCount() const { return cells.size(); }
+    float GetItemRadius() const { return itemRadius; }
+
+    // Broad phase: ids of all items sharing a cell with the ray segment [0, maxDistance],
+    // in the order the ray reaches them. Callers do the exact sphere test.
+    void RayQuery(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, std::vector<unsigned int>& out) const;
+
+    // Exact: ids of items whose center lies within halfAngleDeg of dir and within maxDistance.
+    // Narrow cones walk the cells along the axis (within the occupied bounds); wide ones scan
+    // the occupied cells, whichever visits fewer. Cost scales with cells, not items.
+    void ConeQuery(const glm::vec3& origin, const glm::vec3& dir, float halfAngleDeg, float maxDistance, std::vector<unsigned int>& out) const;
+
+    // Exact: ids of items whose center lies within radius of center. Stateless, safe to call from several threads.
+    void SphereQuery(const glm::vec3& center, float radius, std::vector<unsigned int>& out) const;
+
+private:
+    static const int MAX_CELLS_PER_ITEM = 8;
+
+    struct CellEntry {
+        unsigned int id;
+        unsigned int sub; // Which of the item's links this is (0 = home cell, holds the center)
+    };
+
+    struct Item {
+        glm::vec3 position;
+        bool alive = false;
+        int cellCount = 0;
+        uint64_t cellKeys[MAX_CELLS_PER_ITEM];
+        unsigned int slots[MAX_CELLS_PER_ITEM]; // Index inside the cell's entry list
+    };
+
+    float cellSize;
+    float invCellSize;
+    float itemRadius;
+    size_t count;
+
+    std::unordered_map<uint64_t, std::vector<CellEntry>> cells; // Occupied cells only
+    std::vector<Item> items;
+    glm::ivec3 boundsMin, boundsMax; // Every cell linked since Clear (never shrinks)
+
+    // Ray queries visit an item once per cell it spans; stamps filter the duplicates
+    mutable std::vector<unsigned int> stamps;
+    mutable unsigned int queryStamp;
+    // Cone queries: cell boxes of the axis slices
+    mutable std::vector<std::pair<glm::ivec3, glm::ivec3>> sliceBoxes;
+
+    glm::ivec3 CellOf(const glm::vec3& p) const;
+    static uint64_t Key(int x, int y, int z);
+    void Link(unsigned int id);
+    void Unlink(unsigned int id);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef TARGETPOOL_H
+#define TARGETPOOL_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Stable reference to a target. 'slot' never moves while the target lives;
+// 'generation' is bumped on every destroy so stale handles are rejected.
+struct TargetHandle {
+    uint32_t slot = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+
+    bool operator==(const TargetHandle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const TargetHandle& o) const { return !(*this == o); }
+};
+
+// Structure-of-arrays slot map for targets.
+// Live targets are packed in dense columns [0, Size()); destroy swap-removes the
+// last element into the hole, so every per-frame loop runs over contiguous memory.
+class TargetPool {
+public:
+    // Dense columns (read/write through the accessors below, never resize directly)
+    std::vector<float> PosX, PosY, PosZ;
+    std::vector<float> VelX, VelY, VelZ; // Zero for static targets, driven by DroneSwarm otherwise
+    std::vector<float> PrevX, PrevY, PrevZ; // Position before the last simulation step (render interpolation)
+    std::vector<float> ActiveTime;
+    std::vector<uint8_t> IsActive;
+
+    TargetHandle Create(const glm::vec3& position, const glm::vec3& velocity = glm::vec3(0.0f));
+    bool Destroy(TargetHandle handle);
+    void Clear();
+    void Reserve(size_t capacity);
+
+    bool IsValid(TargetHandle handle) const;
+    size_t Size() const { return denseToSlot.size(); }
+    bool Empty() const { return denseToSlot.empty(); }
+
+    // Dense index <-> handle/slot
+    uint32_t DenseIndex(TargetHandle handle) const { return slotToDense[handle.slot]; }
+    uint32_t DenseIndexOfSlot(uint32_t slot) const { return slotToDense[slot]; }
+    uint32_t SlotAt(size_t denseIndex) const { return denseToSlot[denseIndex]; }
+    TargetHandle HandleAt(size_t denseIndex) const;
+    glm::vec3 PositionAt(size_t denseIndex) const { return glm::vec3(PosX[denseIndex], PosY[denseIndex], PosZ[denseIndex]); }
+    glm::vec3 VelocityAt(size_t denseIndex) const { return glm::vec3(VelX[denseIndex], VelY[denseIndex], VelZ[denseIndex]); }
+
+    // --- Column kernels ---
+    // activeTime += dt for every target
+    void Age(float deltaTime);
+    // Dense index of the nearest active target within maxDistance whose sphere is hit by the ray
+    // (ahead of the origin), or -1. Brute force, but cheaper than a grid walk for small pools.
+    int RayScan(const glm::vec3& origin, const glm::vec3& dir, float radius, float maxDistance, float* outDistance = nullptr) const;
+    // Prev = Pos, at the start of every simulation step
+    void SavePrevious();
+    // Interleave positions as xyz triples for the instance buffer, interpolated from the previous
+    // step by alpha (1 = current state); returns number of instances written
+    size_t FillInstanceOffsets(float* out, float alpha = 1.0f) const;
+
+private:
+    std::vector<uint32_t> denseToSlot;
+    std::vector<uint32_t> slotToDense;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeSlots;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef TARGETRENDERER_H
+#define TARGETRENDERER_H
+
+#include <glad/glad.h>
+#include <cstddef>
+
+#include "Shader.h"
+#include "RenderCommands.h"
+
+// Draws the live targets as one instanced cube batch. Owns all GL state of the targets,
+// so GameManager stays free of GL and can simulate without a context.
+class TargetRenderer {
+public:
+    TargetRenderer();
+    ~TargetRenderer();
+
+    // Needs a current context; Render is a no-op before this
+    void Init();
+    // Offsets filled elsewhere (xyz per target, TargetPool::FillInstanceOffsets, e.g. by the game
+    // thread into a RenderPacket). Recorded into cmd; the offsets are copied, so they may change
+    // once this returns.
+    void Render(Shader& shader, const float* offsets, size_t count,
+                RenderCommandBuffer& cmd = RenderCommandBuffer::Immediate());
+
+private:
+    unsigned int cubeVAO, cubeVBO, instanceVBO;
+};
+
+#endif
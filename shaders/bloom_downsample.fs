@@ -0,0 +1,78 @@
+#version 330 core
+out vec3 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D srcTexture;
+uniform bool firstPass;   // Full-resolution source: apply threshold and Karis average
+uniform float threshold;
+uniform float knee;
+
+float luminance(vec3 c)
+{
+    return dot(c, vec3(0.2126, 0.7152, 0.0722));
+}
+
+// Soft-knee bright pass (quadratic ramp around the threshold instead of a hard cut)
+vec3 prefilter(vec3 c)
+{
+    float brightness = max(c.r, max(c.g, c.b));
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 1e-4);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 1e-4);
+    return c * contribution;
+}
+
+// Karis average: weight by 1 / (1 + luma) so single very bright texels do not flicker
+vec3 karis(vec3 a, vec3 b, vec3 c, vec3 d)
+{
+    float wa = 1.0 / (1.0 + luminance(a));
+    float wb = 1.0 / (1.0 + luminance(b));
+    float wc = 1.0 / (1.0 + luminance(c));
+    float wd = 1.0 / (1.0 + luminance(d));
+    return (a * wa + b * wb + c * wc + d * wd) / (wa + wb + wc + wd);
+}
+
+void main()
+{
+    vec2 t = 1.0 / vec2(textureSize(srcTexture, 0));
+    float x = t.x;
+    float y = t.y;
+
+    // 13 bilinear taps around the destination texel:
+    // a - b - c
+    // - j - k -
+    // d - e - f
+    // - l - m -
+    // g - h - i
+    vec3 a = texture(srcTexture, TexCoords + vec2(-2.0 * x,  2.0 * y)).rgb;
+    vec3 b = texture(srcTexture, TexCoords + vec2( 0.0,      2.0 * y)).rgb;
+    vec3 c = texture(srcTexture, TexCoords + vec2( 2.0 * x,  2.0 * y)).rgb;
+    vec3 d = texture(srcTexture, TexCoords + vec2(-2.0 * x,  0.0)).rgb;
+    vec3 e = texture(srcTexture, TexCoords).rgb;
+    vec3 f = texture(srcTexture, TexCoords + vec2( 2.0 * x,  0.0)).rgb;
+    vec3 g = texture(srcTexture, TexCoords + vec2(-2.0 * x, -2.0 * y)).rgb;
+    vec3 h = texture(srcTexture, TexCoords + vec2( 0.0,     -2.0 * y)).rgb;
+    vec3 i = texture(srcTexture, TexCoords + vec2( 2.0 * x, -2.0 * y)).rgb;
+    vec3 j = texture(srcTexture, TexCoords + vec2(-x,  y)).rgb;
+    vec3 k = texture(srcTexture, TexCoords + vec2( x,  y)).rgb;
+    vec3 l = texture(srcTexture, TexCoords + vec2(-x, -y)).rgb;
+    vec3 m = texture(srcTexture, TexCoords + vec2( x, -y)).rgb;
+
+    // Five overlapping 2x2 boxes: center 0.5, corners 0.125 each
+    vec3 result;
+    if (firstPass) {
+        vec3 g0 = karis(prefilter(a), prefilter(b), prefilter(d), prefilter(e));
+        vec3 g1 = karis(prefilter(b), prefilter(c), prefilter(e), prefilter(f));
+        vec3 g2 = karis(prefilter(d), prefilter(e), prefilter(g), prefilter(h));
+        vec3 g3 = karis(prefilter(e), prefilter(f), prefilter(h), prefilter(i));
+        vec3 g4 = karis(prefilter(j), prefilter(k), prefilter(l), prefilter(m));
+        result = g4 * 0.5 + (g0 + g1 + g2 + g3) * 0.125;
+    } else {
+        result  = e * 0.125;
+        result += (a + c + g + i) * 0.03125;
+        result += (b + d + f + h) * 0.0625;
+        result += (j + k + l + m) * 0.125;
+    }
+    FragColor = max(result, vec3(0.0));
+}
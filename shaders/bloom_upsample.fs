@@ -0,0 +1,25 @@
+#version 330 core
+out vec3 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D srcTexture;
+uniform vec2 texelSize; // Filter radius in UV of the source (smaller) level
+
+void main()
+{
+    float x = texelSize.x;
+    float y = texelSize.y;
+
+    // 3x3 tent filter, weights 1-2-1 / 16
+    vec3 result = texture(srcTexture, TexCoords).rgb * 4.0;
+    result += (texture(srcTexture, TexCoords + vec2(-x, 0.0)).rgb +
+               texture(srcTexture, TexCoords + vec2( x, 0.0)).rgb +
+               texture(srcTexture, TexCoords + vec2(0.0, -y)).rgb +
+               texture(srcTexture, TexCoords + vec2(0.0,  y)).rgb) * 2.0;
+    result += (texture(srcTexture, TexCoords + vec2(-x, -y)).rgb +
+               texture(srcTexture, TexCoords + vec2( x, -y)).rgb +
+               texture(srcTexture, TexCoords + vec2(-x,  y)).rgb +
+               texture(srcTexture, TexCoords + vec2( x,  y)).rgb);
+    FragColor = result / 16.0;
+}
@@ -0,0 +1,119 @@
+#version 330 core
+// FXAA (after Lottes' FXAA 3.11 "quality" path) on the final tone-mapped image.
+// 1. Skip pixels whose local luma contrast is low.
+// 2. Pick the edge orientation and the steeper side.
+// 3. Walk along the edge in both directions until the luma changes,
+//    then blend towards the side based on where the pixel sits on the edge span.
+// 4. Sub-pixel aliasing (single-pixel features) gets an extra low-pass blend.
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D image;   // LDR, display-referred (needs linear filtering)
+uniform vec2 texelSize;
+
+const float EDGE_THRESHOLD_MIN = 0.0312;
+const float EDGE_THRESHOLD_MAX = 0.125;
+const float SUBPIXEL_QUALITY = 0.75;
+const int SEARCH_STEPS = 12;
+const float STEP_SCALE[12] = float[](1.0, 1.0, 1.0, 1.0, 1.0, 1.5, 2.0, 2.0, 2.0, 2.0, 4.0, 8.0);
+
+float luma(vec3 c) {
+    return dot(c, vec3(0.299, 0.587, 0.114));
+}
+
+float lumaAt(vec2 uv) {
+    return luma(texture(image, uv).rgb);
+}
+
+void main()
+{
+    vec3 colorM = texture(image, TexCoords).rgb;
+    float lumaM = luma(colorM);
+    float lumaN = luma(textureOffset(image, TexCoords, ivec2( 0,  1)).rgb);
+    float lumaS = luma(textureOffset(image, TexCoords, ivec2( 0, -1)).rgb);
+    float lumaE = luma(textureOffset(image, TexCoords, ivec2( 1,  0)).rgb);
+    float lumaW = luma(textureOffset(image, TexCoords, ivec2(-1,  0)).rgb);
+
+    float lumaMin = min(lumaM, min(min(lumaN, lumaS), min(lumaE, lumaW)));
+    float lumaMax = max(lumaM, max(max(lumaN, lumaS), max(lumaE, lumaW)));
+    float range = lumaMax - lumaMin;
+    if (range < max(EDGE_THRESHOLD_MIN, lumaMax * EDGE_THRESHOLD_MAX)) {
+        FragColor = vec4(colorM, 1.0);
+        return;
+    }
+
+    float lumaNW = luma(textureOffset(image, TexCoords, ivec2(-1,  1)).rgb);
+    float lumaNE = luma(textureOffset(image, TexCoords, ivec2( 1,  1)).rgb);
+    float lumaSW = luma(textureOffset(image, TexCoords, ivec2(-1, -1)).rgb);
+    float lumaSE = luma(textureOffset(image, TexCoords, ivec2( 1, -1)).rgb);
+
+    // Orientation: compare the second derivatives across rows and columns
+    float edgeHorizontal = abs(lumaNW + lumaSW - 2.0 * lumaW) + 2.0 * abs(lumaN + lumaS - 2.0 * lumaM) + abs(lumaNE + lumaSE - 2.0 * lumaE);
+    float edgeVertical   = abs(lumaNW + lumaNE - 2.0 * lumaN) + 2.0 * abs(lumaW + lumaE - 2.0 * lumaM) + abs(lumaSW + lumaSE - 2.0 * lumaS);
+    bool isHorizontal = edgeHorizontal >= edgeVertical;
+
+    float luma1 = isHorizontal ? lumaS : lumaW;
+    float luma2 = isHorizontal ? lumaN : lumaE;
+    float gradient1 = luma1 - lumaM;
+    float gradient2 = luma2 - lumaM;
+    bool is1Steepest = abs(gradient1) >= abs(gradient2);
+    float gradientScaled = 0.25 * max(abs(gradient1), abs(gradient2));
+
+    float stepLength = isHorizontal ? texelSize.y : texelSize.x;
+    float lumaLocalAverage;
+    if (is1Steepest) {
+        stepLength = -stepLength;
+        lumaLocalAverage = 0.5 * (luma1 + lumaM);
+    } else {
+        lumaLocalAverage = 0.5 * (luma2 + lumaM);
+    }
+
+    // Start half a pixel towards the steeper side, on the edge itself
+    vec2 edgeUv = TexCoords;
+    if (isHorizontal) edgeUv.y += stepLength * 0.5;
+    else edgeUv.x += stepLength * 0.5;
+
+    vec2 offset = isHorizontal ? vec2(texelSize.x, 0.0) : vec2(0.0, texelSize.y);
+    vec2 uv1 = edgeUv - offset;
+    vec2 uv2 = edgeUv + offset;
+    float lumaEnd1 = lumaAt(uv1) - lumaLocalAverage;
+    float lumaEnd2 = lumaAt(uv2) - lumaLocalAverage;
+    bool reached1 = abs(lumaEnd1) >= gradientScaled;
+    bool reached2 = abs(lumaEnd2) >= gradientScaled;
+
+    for (int i = 0; i < SEARCH_STEPS && !(reached1 && reached2); i++) {
+        if (!reached1) {
+            uv1 -= offset * STEP_SCALE[i];
+            lumaEnd1 = lumaAt(uv1) - lumaLocalAverage;
+            reached1 = abs(lumaEnd1) >= gradientScaled;
+        }
+        if (!reached2) {
+            uv2 += offset * STEP_SCALE[i];
+            lumaEnd2 = lumaAt(uv2) - lumaLocalAverage;
+            reached2 = abs(lumaEnd2) >= gradientScaled;
+        }
+    }
+
+    float distance1 = isHorizontal ? (TexCoords.x - uv1.x) : (TexCoords.y - uv1.y);
+    float distance2 = isHorizontal ? (uv2.x - TexCoords.x) : (uv2.y - TexCoords.y);
+    bool isDirection1 = distance1 < distance2;
+    float distanceFinal = min(distance1, distance2);
+    float edgeLength = distance1 + distance2;
+    float pixelOffset = -distanceFinal / edgeLength + 0.5;
+
+    // Only blend if the nearer end goes the way the center pixel does
+    bool isLumaCenterSmaller = lumaM < lumaLocalAverage;
+    bool correctVariation = ((isDirection1 ? lumaEnd1 : lumaEnd2) < 0.0) != isLumaCenterSmaller;
+    float finalOffset = correctVariation ? pixelOffset : 0.0;
+
+    float lumaAverage = (1.0 / 12.0) * (2.0 * (lumaN + lumaS + lumaE + lumaW) + lumaNW + lumaNE + lumaSW + lumaSE);
+    float subPixelOffset1 = clamp(abs(lumaAverage - lumaM) / range, 0.0, 1.0);
+    float subPixelOffset2 = (-2.0 * subPixelOffset1 + 3.0) * subPixelOffset1 * subPixelOffset1;
+    finalOffset = max(finalOffset, subPixelOffset2 * subPixelOffset2 * SUBPIXEL_QUALITY);
+
+    vec2 finalUv = TexCoords;
+    if (isHorizontal) finalUv.y += finalOffset * stepLength;
+    else finalUv.x += finalOffset * stepLength;
+    FragColor = vec4(texture(image, finalUv).rgb, 1.0);
+}
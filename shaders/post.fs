@@ -0,0 +1,185 @@
+#version 330 core
+// Uber post-process shader. PostProcessor compiles one variant per feature set
+// by prepending #defines, so disabled features are not in the binary at all:
+//   USE_BLOOM     add the bloom texture
+//   USE_GLITCH    UV jitter + chromatic aberration
+//   USE_RAIN      three procedural rain layers
+//   USE_TONEMAP   exposure tone mapping (otherwise clamp)
+//   USE_VIGNETTE  darken the edges
+//   USE_UPSCALE   Catmull-Rom sampling of the scene (rendered below display size)
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D screenTexture;
+uniform float time;
+
+#ifdef USE_BLOOM
+uniform sampler2D bloomBlur;
+uniform float bloomStrength; // Scale of the bloom texture (depends on the bloom mode)
+#endif
+#ifdef USE_TONEMAP
+uniform float exposure;
+#endif
+#ifdef USE_VIGNETTE
+uniform float vignetteStrength;
+#endif
+
+#ifdef USE_UPSCALE
+// Catmull-Rom bicubic in 9 bilinear taps: the middle two weights of each axis are
+// merged into one filtered fetch. Sharper than bilinear when upscaling.
+vec3 sampleScene(vec2 uv)
+{
+    vec2 texSize = vec2(textureSize(screenTexture, 0));
+    vec2 samplePos = uv * texSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+
+    vec2 pos0 = (texPos1 - 1.0) / texSize;
+    vec2 pos3 = (texPos1 + 2.0) / texSize;
+    vec2 pos12 = (texPos1 + w2 / w12) / texSize;
+
+    vec3 result = vec3(0.0);
+    result += texture(screenTexture, vec2(pos0.x,  pos0.y)).rgb  * w0.x  * w0.y;
+    result += texture(screenTexture, vec2(pos12.x, pos0.y)).rgb  * w12.x * w0.y;
+    result += texture(screenTexture, vec2(pos3.x,  pos0.y)).rgb  * w3.x  * w0.y;
+    result += texture(screenTexture, vec2(pos0.x,  pos12.y)).rgb * w0.x  * w12.y;
+    result += texture(screenTexture, vec2(pos12.x, pos12.y)).rgb * w12.x * w12.y;
+    result += texture(screenTexture, vec2(pos3.x,  pos12.y)).rgb * w3.x  * w12.y;
+    result += texture(screenTexture, vec2(pos0.x,  pos3.y)).rgb  * w0.x  * w3.y;
+    result += texture(screenTexture, vec2(pos12.x, pos3.y)).rgb  * w12.x * w3.y;
+    result += texture(screenTexture, vec2(pos3.x,  pos3.y)).rgb  * w3.x  * w3.y;
+    // The negative lobes can ring below zero next to bright HDR edges
+    return max(result, vec3(0.0));
+}
+#else
+vec3 sampleScene(vec2 uv)
+{
+    return texture(screenTexture, uv).rgb;
+}
+#endif
+
+#if defined(USE_GLITCH) || defined(USE_RAIN)
+// Simple pseudo-random function
+float rand(vec2 co){
+    return fract(sin(dot(co, vec2(12.9898, 78.233))) * 43758.5453);
+}
+#endif
+
+#ifdef USE_RAIN
+// --- Improved Cyberpunk Rain (Depth & Glitch) ---
+float rain(vec2 uv)
+{
+    // Slant calculation
+    vec2 rUV = uv;
+    rUV.x -= rUV.y * 0.1; // Slanted rain
+
+    float rainTotal = 0.0;
+
+    // Layer 1: Background (Dense, slow, faint) - "Mist Rain"
+    {
+        vec2 st = rUV * vec2(100.0, 1.0); // Very thin
+        float t = time * 0.5; // Slow
+        float col = floor(st.x);
+        float y = st.y + t + rand(vec2(col, 1.0));
+        if(rand(vec2(col, floor(y))) > 0.95) {
+            float f = fract(y);
+            rainTotal += pow(f, 5.0) * 0.1;
+        }
+    }
+
+    // Layer 2: Midground (Normal rain)
+    {
+        vec2 st = rUV * vec2(60.0, 1.0);
+        float t = time * 1.5;
+        float col = floor(st.x);
+        float y = st.y + t + rand(vec2(col, 2.0));
+        if(rand(vec2(col, floor(y))) > 0.90) { // More drops
+            float f = fract(y);
+            // Shape drop
+            float xDist = abs(fract(st.x) - 0.5);
+            if (xDist < 0.4) {
+                 rainTotal += pow(f, 10.0) * 0.4;
+            }
+        }
+    }
+
+    // Layer 3: Foreground (Fast, bright, few) - "Camera Hits"
+    {
+        vec2 st = rUV * vec2(30.0, 1.0);
+        float t = time * 3.0; // Fast
+        float col = floor(st.x);
+        float off = rand(vec2(col, 3.5));
+        float y = st.y + t * (1.2 + off * 0.5);
+        if(rand(vec2(col, floor(y))) > 0.97) {
+            float f = fract(y);
+            // Thick drops
+            float xDist = abs(fract(st.x) - 0.5);
+            float thickness = 1.0 - smoothstep(0.0, 0.5, xDist);
+            rainTotal += pow(f, 20.0) * thickness * 0.8;
+        }
+    }
+    return rainTotal;
+}
+#endif
+
+void main()
+{
+    vec2 uv = TexCoords;
+
+#ifdef USE_GLITCH
+    // Continuous glitch effect, varying strength but always active
+    float glitchStrength = 0.05 + 0.05 * sin(time * 3.0);
+
+    // XY jitter
+    float rnd = rand(vec2(time, floor(uv.y * 10.0))); // Blocky effect
+    // Vignette mask: Glitch affects edges more than center
+    float mask = smoothstep(0.1, 0.7, distance(uv, vec2(0.5))); // 0 at center, 1 at edges
+    if (rnd < 0.3) {
+        uv.x += rnd * 0.05 * sin(time) * glitchStrength * mask;
+    }
+
+    // Chromatic aberration
+    float redShift = 0.01 * glitchStrength;
+    float greenShift = 0.005 * glitchStrength;
+    vec3 col;
+    col.r = sampleScene(uv + vec2(redShift, 0)).r;
+    col.g = sampleScene(uv + vec2(-greenShift, 0)).g;
+    col.b = sampleScene(uv).b;
+#else
+    vec3 col = sampleScene(uv);
+#endif
+
+#ifdef USE_BLOOM
+    // Sampled at the (glitched) uv so bloom follows the jitter
+    col += texture(bloomBlur, uv).rgb * bloomStrength; // additive blending
+#endif
+
+#ifdef USE_TONEMAP
+    vec3 result = vec3(1.0) - exp(-col * exposure);
+#else
+    vec3 result = clamp(col, 0.0, 1.0);
+#endif
+
+#ifdef USE_RAIN
+    // Rain Color (Cyberpunk Cyan/White), added after tone mapping
+    result += vec3(0.7, 0.9, 1.0) * rain(TexCoords);
+#endif
+
+#ifdef USE_VIGNETTE
+    float d = distance(TexCoords, vec2(0.5));
+    result *= 1.0 - vignetteStrength * smoothstep(0.3, 0.8, d);
+#endif
+
+    // Gamma correction
+    const float gamma = 2.2;
+    result = pow(result, vec3(1.0 / gamma));
+
+    FragColor = vec4(result, 1.0);
+}
@@ -1,25 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoords;
-
-uniform sampler2D screenTexture;
-uniform sampler2D bloomBlur;
-uniform bool bloom;
-uniform float exposure;
-
-void main()
-{
-    const float gamma = 2.2;
-    vec3 col = texture(screenTexture, TexCoords).rgb;
-    vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
-    if(bloom)
-        col += bloomColor; // additive blending
-    
-    // Tone mapping
-    vec3 result = vec3(1.0) - exp(-col * exposure);
-    // Gamma correction 
-    result = pow(result, vec3(1.0 / gamma));
-    
-    FragColor = vec4(result, 1.0);
-}
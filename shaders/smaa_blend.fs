@@ -0,0 +1,36 @@
+#version 330 core
+// SMAA 1x, pass 3: neighbourhood blending.
+// Gathers the four weights that concern this pixel (its own top/left, the bottom
+// neighbour's "takes from above" and the right neighbour's "takes from the left")
+// and blends along the dominant axis.
+out vec4 FragColor;
+
+uniform sampler2D image;      // LDR, display-referred
+uniform sampler2D weightsTex;
+
+vec4 colorAt(ivec2 p) {
+    return texelFetch(image, clamp(p, ivec2(0), textureSize(image, 0) - 1), 0);
+}
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(weightsTex, 0);
+    vec4 w = texelFetch(weightsTex, p, 0);
+    float top = w.r;
+    float left = w.b;
+    float bottom = p.y > 0 ? texelFetch(weightsTex, p + ivec2(0, -1), 0).g : 0.0;
+    float right = p.x + 1 < size.x ? texelFetch(weightsTex, p + ivec2(1, 0), 0).a : 0.0;
+
+    vec4 color = colorAt(p);
+    if (top + bottom + left + right < 1e-5) {
+        FragColor = vec4(color.rgb, 1.0);
+        return;
+    }
+
+    if (max(top, bottom) >= max(left, right))
+        color = color * (1.0 - top - bottom) + colorAt(p + ivec2(0, 1)) * top + colorAt(p + ivec2(0, -1)) * bottom;
+    else
+        color = color * (1.0 - left - right) + colorAt(p + ivec2(-1, 0)) * left + colorAt(p + ivec2(1, 0)) * right;
+    FragColor = vec4(color.rgb, 1.0);
+}
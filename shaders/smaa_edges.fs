@@ -0,0 +1,41 @@
+#version 330 core
+// SMAA 1x, pass 1: luma edge detection with local contrast adaptation.
+// R = edge with the left neighbour, G = edge with the top neighbour.
+// Pixels without edges are discarded (the target is cleared to 0).
+out vec4 FragColor;
+
+uniform sampler2D image;   // LDR, display-referred
+uniform float threshold;
+
+// An edge only counts if it is not much weaker than the strongest one around it
+const float LOCAL_CONTRAST_ADAPTATION = 2.0;
+
+float lumaAt(ivec2 p) {
+    p = clamp(p, ivec2(0), textureSize(image, 0) - 1);
+    return dot(texelFetch(image, p, 0).rgb, vec3(0.2126, 0.7152, 0.0722));
+}
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    float L = lumaAt(p);
+    float Lleft = lumaAt(p + ivec2(-1, 0));
+    float Ltop = lumaAt(p + ivec2(0, 1));
+
+    vec2 delta = abs(L - vec2(Lleft, Ltop));
+    vec2 edges = step(threshold, delta);
+    if (edges.x + edges.y == 0.0)
+        discard;
+
+    // Neighbouring deltas: right/bottom, and the far side of left/top
+    float Lright = lumaAt(p + ivec2(1, 0));
+    float Lbottom = lumaAt(p + ivec2(0, -1));
+    vec2 maxDelta = max(delta, abs(L - vec2(Lright, Lbottom)));
+    float LleftLeft = lumaAt(p + ivec2(-2, 0));
+    float LtopTop = lumaAt(p + ivec2(0, 2));
+    maxDelta = max(maxDelta, abs(vec2(Lleft, Ltop) - vec2(LleftLeft, LtopTop)));
+
+    float finalDelta = max(maxDelta.x, maxDelta.y);
+    edges *= step(finalDelta, LOCAL_CONTRAST_ADAPTATION * delta);
+    FragColor = vec4(edges, 0.0, 0.0);
+}
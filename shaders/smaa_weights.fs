@@ -0,0 +1,102 @@
+#version 330 core
+// SMAA 1x, pass 2: blending weights.
+// For every edge the line it belongs to is followed both ways (up to MAX_SEARCH pixels),
+// the crossing edges at its ends give the shape (L, Z or U), and the revectorized
+// silhouette gives how much of this pixel lies on the other side of it.
+// SMAA reads that area from a precomputed AreaTex; here it is computed analytically
+// (same trapezoid/triangle integration the texture is generated with). Diagonal
+// patterns and corner rounding are not handled.
+// Output: R = this pixel takes from its top neighbour, G = the top neighbour takes from this pixel,
+//         B = this pixel takes from its left neighbour, A = the left neighbour takes from this pixel.
+out vec4 FragColor;
+
+uniform sampler2D edgesTex;
+
+const int MAX_SEARCH = 16;
+
+ivec2 size;
+
+vec2 edgeAt(ivec2 p) {
+    if (any(lessThan(p, ivec2(0))) || any(greaterThanEqual(p, size))) return vec2(0.0);
+    return texelFetch(edgesTex, p, 0).rg;
+}
+
+// Height of the silhouette at a line end: -0.5 if the crossing edge is on this pixel's side,
+// +0.5 on the neighbour's side, 0 if there is none (or both: ambiguous)
+float endHeight(float ownSide, float otherSide) {
+    if (ownSide > 0.5 && otherSide < 0.5) return -0.5;
+    if (otherSide > 0.5 && ownSide < 0.5) return 0.5;
+    return 0.0;
+}
+
+// Area between the segment a -> b and the edge (y = 0) over [x0, x1]:
+// x = part above (neighbour side), y = part below (this pixel's side)
+vec2 segmentArea(vec2 a, vec2 b, float x0, float x1) {
+    float lo = max(x0, a.x);
+    float hi = min(x1, b.x);
+    if (hi <= lo) return vec2(0.0);
+    float ya = mix(a.y, b.y, (lo - a.x) / (b.x - a.x));
+    float yb = mix(a.y, b.y, (hi - a.x) / (b.x - a.x));
+    if (ya * yb >= 0.0) {
+        float area = 0.5 * (ya + yb) * (hi - lo);
+        return area > 0.0 ? vec2(area, 0.0) : vec2(0.0, -area);
+    }
+    // Crosses the edge inside the pixel: two triangles
+    float xc = lo + (hi - lo) * ya / (ya - yb);
+    float a1 = 0.5 * ya * (xc - lo);
+    float a2 = 0.5 * yb * (hi - xc);
+    return vec2(max(a1, 0.0) + max(a2, 0.0), max(-a1, 0.0) + max(-a2, 0.0));
+}
+
+// Coverage of the pixel [d1, d1 + 1] on a line of length d1 + d2 + 1 with end heights h1, h2
+vec2 lineArea(float d1, float d2, float h1, float h2) {
+    float len = d1 + d2 + 1.0;
+    if (h1 != 0.0 && h2 != 0.0 && h1 != h2) // Z: one slope over the whole line
+        return segmentArea(vec2(0.0, h1), vec2(len, h2), d1, d1 + 1.0);
+    // L (one end) or U (both ends on the same side): each end slopes to the middle
+    vec2 area = vec2(0.0);
+    if (h1 != 0.0) area += segmentArea(vec2(0.0, h1), vec2(0.5 * len, 0.0), d1, d1 + 1.0);
+    if (h2 != 0.0) area += segmentArea(vec2(0.5 * len, 0.0), vec2(len, h2), d1, d1 + 1.0);
+    return area;
+}
+
+void main()
+{
+    size = textureSize(edgesTex, 0);
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    vec2 e = edgeAt(p);
+    if (e.r + e.g == 0.0)
+        discard;
+
+    vec4 weights = vec4(0.0);
+
+    // Top edge: a horizontal line, searched left (d1) and right (d2)
+    if (e.g > 0.5) {
+        int d1 = 0;
+        while (d1 < MAX_SEARCH && edgeAt(p + ivec2(-d1 - 1, 0)).g > 0.5) d1++;
+        int d2 = 0;
+        while (d2 < MAX_SEARCH && edgeAt(p + ivec2(d2 + 1, 0)).g > 0.5) d2++;
+        // Crossing edges are the left edges (R) at the ends, in this row or the one above
+        float h1 = d1 < MAX_SEARCH ? endHeight(edgeAt(p + ivec2(-d1, 0)).r, edgeAt(p + ivec2(-d1, 1)).r) : 0.0;
+        float h2 = d2 < MAX_SEARCH ? endHeight(edgeAt(p + ivec2(d2 + 1, 0)).r, edgeAt(p + ivec2(d2 + 1, 1)).r) : 0.0;
+        vec2 area = lineArea(float(d1), float(d2), h1, h2);
+        weights.r = area.y;
+        weights.g = area.x;
+    }
+
+    // Left edge: a vertical line, searched down (d1) and up (d2)
+    if (e.r > 0.5) {
+        int d1 = 0;
+        while (d1 < MAX_SEARCH && edgeAt(p + ivec2(0, -d1 - 1)).r > 0.5) d1++;
+        int d2 = 0;
+        while (d2 < MAX_SEARCH && edgeAt(p + ivec2(0, d2 + 1)).r > 0.5) d2++;
+        // Crossing edges are the top edges (G) at the ends, in this column or the one to the left
+        float h1 = d1 < MAX_SEARCH ? endHeight(edgeAt(p + ivec2(0, -d1 - 1)).g, edgeAt(p + ivec2(-1, -d1 - 1)).g) : 0.0;
+        float h2 = d2 < MAX_SEARCH ? endHeight(edgeAt(p + ivec2(0, d2)).g, edgeAt(p + ivec2(-1, d2)).g) : 0.0;
+        vec2 area = lineArea(float(d1), float(d2), h1, h2);
+        weights.b = area.y;
+        weights.a = area.x;
+    }
+
+    FragColor = weights;
+}
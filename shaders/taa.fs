@@ -0,0 +1,130 @@
+#version 330 core
+// Temporal anti-aliasing resolve.
+// The scene is rendered with a different sub-pixel projection jitter every frame;
+// blending each frame into a reprojected history accumulates those samples into a
+// supersampled image. History that no longer matches (disocclusion, moving drones)
+// is clamped to the colour range of the current 3x3 neighbourhood (in YCoCg).
+//
+// TAA_UPSAMPLE (temporal upscaling): the scene is rendered below the output size and
+// the history is kept at the output size. Each output pixel takes the nearest jittered
+// render sample, weighted by how close it landed, so over the jitter sequence every
+// output pixel collects samples close to its own center.
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D currentColor;   // HDR scene, jittered, single-sample (render size)
+uniform sampler2D currentDepth;
+uniform sampler2D historyColor;   // Last frame's output (output size)
+uniform mat4 reprojection;        // prevViewProjection * inverse(viewProjection), both unjittered
+uniform vec2 jitterUV;            // This frame's jitter in UV units
+uniform float feedback;           // Weight of the history (0 = no AA, ~0.9 typical)
+uniform bool resetHistory;
+
+vec3 RGBToYCoCg(vec3 c) {
+    return vec3(0.25 * c.r + 0.5 * c.g + 0.25 * c.b,
+                0.5 * c.r - 0.5 * c.b,
+               -0.25 * c.r + 0.5 * c.g - 0.25 * c.b);
+}
+
+vec3 YCoCgToRGB(vec3 c) {
+    return vec3(c.x + c.y - c.z, c.x + c.z, c.x - c.y - c.z);
+}
+
+#ifdef TAA_UPSAMPLE
+// Catmull-Rom in 9 bilinear taps; a plain bilinear history read would soften the
+// image a little more every frame
+vec3 sampleHistory(vec2 uv)
+{
+    vec2 texSize = vec2(textureSize(historyColor, 0));
+    vec2 samplePos = uv * texSize;
+    vec2 texPos1 = floor(samplePos - 0.5) + 0.5;
+    vec2 f = samplePos - texPos1;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+
+    vec2 pos0 = (texPos1 - 1.0) / texSize;
+    vec2 pos3 = (texPos1 + 2.0) / texSize;
+    vec2 pos12 = (texPos1 + w2 / w12) / texSize;
+
+    vec3 result = vec3(0.0);
+    result += texture(historyColor, vec2(pos0.x,  pos0.y)).rgb  * w0.x  * w0.y;
+    result += texture(historyColor, vec2(pos12.x, pos0.y)).rgb  * w12.x * w0.y;
+    result += texture(historyColor, vec2(pos3.x,  pos0.y)).rgb  * w3.x  * w0.y;
+    result += texture(historyColor, vec2(pos0.x,  pos12.y)).rgb * w0.x  * w12.y;
+    result += texture(historyColor, vec2(pos12.x, pos12.y)).rgb * w12.x * w12.y;
+    result += texture(historyColor, vec2(pos3.x,  pos12.y)).rgb * w3.x  * w12.y;
+    result += texture(historyColor, vec2(pos0.x,  pos3.y)).rgb  * w0.x  * w3.y;
+    result += texture(historyColor, vec2(pos12.x, pos3.y)).rgb  * w12.x * w3.y;
+    result += texture(historyColor, vec2(pos3.x,  pos3.y)).rgb  * w3.x  * w3.y;
+    return max(result, vec3(0.0));
+}
+#else
+vec3 sampleHistory(vec2 uv)
+{
+    return texture(historyColor, uv).rgb;
+}
+#endif
+
+void main()
+{
+    ivec2 size = textureSize(currentColor, 0);
+#ifdef TAA_UPSAMPLE
+    // Render samples sit at the jittered render pixel centers; take the nearest one
+    vec2 renderPos = (TexCoords + jitterUV) * vec2(size);
+    ivec2 center = clamp(ivec2(floor(renderPos)), ivec2(0), size - 1);
+    vec2 sampleOffset = renderPos - (vec2(center) + 0.5); // Render pixels
+    float sampleWeight = exp(-2.29 * dot(sampleOffset, sampleOffset)); // Gaussian fit of Blackman-Harris
+#else
+    ivec2 center = ivec2(gl_FragCoord.xy);
+    float sampleWeight = 1.0;
+#endif
+    vec3 current = texelFetch(currentColor, center, 0).rgb;
+    if (resetHistory) {
+#ifdef TAA_UPSAMPLE
+        current = texture(currentColor, TexCoords + jitterUV).rgb;
+#endif
+        FragColor = vec4(current, 1.0);
+        return;
+    }
+
+    // Neighbourhood bounds (and the closest depth, so edges reproject with the foreground)
+    vec3 minColor = vec3(1e9);
+    vec3 maxColor = vec3(-1e9);
+    float closestDepth = 1.0;
+    ivec2 closest = center;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 p = clamp(center + ivec2(x, y), ivec2(0), size - 1);
+            vec3 c = RGBToYCoCg(texelFetch(currentColor, p, 0).rgb);
+            minColor = min(minColor, c);
+            maxColor = max(maxColor, c);
+            float d = texelFetch(currentDepth, p, 0).r;
+            if (d < closestDepth) {
+                closestDepth = d;
+                closest = p;
+            }
+        }
+    }
+    vec2 closestUv = (vec2(closest) + 0.5) / vec2(size);
+
+    // Camera reprojection: where this surface was on screen last frame
+    vec4 ndc = vec4((closestUv - jitterUV) * 2.0 - 1.0, closestDepth * 2.0 - 1.0, 1.0);
+    vec4 previous = reprojection * ndc;
+    vec2 historyUv = TexCoords + (previous.xy / previous.w * 0.5 + 0.5) - (closestUv - jitterUV);
+    if (any(lessThan(historyUv, vec2(0.0))) || any(greaterThan(historyUv, vec2(1.0)))) {
+#ifdef TAA_UPSAMPLE
+        current = texture(currentColor, TexCoords + jitterUV).rgb;
+#endif
+        FragColor = vec4(current, 1.0);
+        return;
+    }
+
+    vec3 history = RGBToYCoCg(sampleHistory(historyUv));
+    history = YCoCgToRGB(clamp(history, minColor, maxColor));
+    FragColor = vec4(mix(history, current, (1.0 - feedback) * sampleWeight), 1.0);
+}
@@ -2,6 +2,7 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aInstanceOffset; // Targets only; (0,0,0) when the array is disabled
 
 out vec2 TexCoords;
 out vec3 Normal;
@@ -14,7 +15,7 @@ uniform mat4 projection;
 void main()
 {
     TexCoords = aTexCoords;    
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(aPos, 1.0)) + aInstanceOffset;
     Normal = mat3(transpose(inverse(model))) * aNormal;  
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
@@ -0,0 +1,125 @@
+#include "BenchmarkReport.h"
+#include "CameraPath.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Driver strings end up inside JSON strings
+static std::string Escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) out += c;
+    }
+    return out;
+}
+
+// One entry of "overall" / "segments": frame time percentiles (via FrameStats) and average draw load
+static void WriteGroup(std::ofstream& out, const char* indent, const std::string& name, const std::vector<BenchmarkReport::Frame>& frames, int segment) {
+    FrameStats stats;
+    stats.CaptureHitches = false;
+    long long count = 0, drawCalls = 0, triangles = 0, tested = 0, culled = 0;
+    for (const BenchmarkReport::Frame& f : frames) {
+        if (segment >= 0 && f.Segment != segment) continue;
+        stats.AddCpuFrame(f.CpuMs);
+        if (f.GpuMs >= 0.0f) stats.AddGpuFrame(f.GpuMs);
+        count++;
+        drawCalls += f.Stats.DrawCalls;
+        triangles += f.Stats.Triangles;
+        tested += f.Stats.MeshesTested;
+        culled += f.Stats.MeshesCulled;
+    }
+    const double n = count > 0 ? static_cast<double>(count) : 1.0;
+    FrameStats::Summary cpu = stats.GetCpuSummary(), gpu = stats.GetGpuSummary();
+
+    char line[512];
+    std::snprintf(line, sizeof(line),
+        "%s{\"name\": \"%s\", \"frames\": %lld,\n"
+        "%s \"cpu_ms\": {\"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f},\n"
+        "%s \"gpu_ms\": {\"frames\": %lld, \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f},\n"
+        "%s \"draw_calls\": %.1f, \"triangles\": %.0f, \"meshes_tested\": %.1f, \"cull_rate\": %.3f}",
+        indent, Escape(name).c_str(), count,
+        indent, cpu.P50, cpu.P95, cpu.P99, cpu.Max, cpu.Mean,
+        indent, gpu.Frames, gpu.P50, gpu.P95, gpu.P99, gpu.Max, gpu.Mean,
+        indent, drawCalls / n, triangles / n, tested / n, tested > 0 ? static_cast<double>(culled) / tested : 0.0);
+    out << line;
+}
+
+float BenchmarkReport::QueryPeakRssMb() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / (1024.0f * 1024.0f);
+    return 0.0f;
+#elif defined(__APPLE__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss / (1024.0f * 1024.0f) : 0.0f; // Bytes
+#elif defined(__unix__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss / 1024.0f : 0.0f; // Kilobytes
+#else
+    return 0.0f;
+#endif
+}
+
+bool BenchmarkReport::WriteCsv(const std::string& file, const CameraPath* path) const {
+    std::ofstream out(file);
+    if (!out) {
+        std::cout << "ERROR::BENCHMARK:: Cannot write " << file << std::endl;
+        return false;
+    }
+    out << "frame,segment,cpu_ms,gpu_ms,draw_calls,triangles,meshes_tested,meshes_culled\n";
+    for (size_t i = 0; i < Frames.size(); i++) {
+        const Frame& f = Frames[i];
+        out << i << ",";
+        if (path && f.Segment >= 0) out << path->GetSegments()[f.Segment].Name;
+        out << "," << f.CpuMs << ",";
+        if (f.GpuMs >= 0.0f) out << f.GpuMs;
+        out << "," << f.Stats.DrawCalls << "," << f.Stats.Triangles << "," << f.Stats.MeshesTested << "," << f.Stats.MeshesCulled << "\n";
+    }
+    return true;
+}
+
+bool BenchmarkReport::WriteJson(const std::string& file, const CameraPath& path) const {
+    std::ofstream out(file);
+    if (!out) {
+        std::cout << "ERROR::BENCHMARK:: Cannot write " << file << std::endl;
+        return false;
+    }
+    char line[512];
+    std::snprintf(line, sizeof(line),
+        "{\n  \"format\": %d,\n"
+        "  \"path\": {\"name\": \"%s\", \"revision\": %d, \"hash\": \"%016llx\", \"frames\": %d, \"duration_s\": %.2f},\n",
+        FORMAT_VERSION, Escape(path.GetName()).c_str(), path.GetRevision(),
+        static_cast<unsigned long long>(path.GetHash()), path.GetFrameCount(), path.GetDuration());
+    out << line;
+    out << "  \"renderer\": \"" << Escape(Renderer) << "\",\n  \"gl_version\": \"" << Escape(GLVersion) << "\",\n";
+    std::snprintf(line, sizeof(line), "  \"resolution\": [%d, %d],\n  \"aa\": \"%s\",\n  \"dynamic_resolution\": %s,\n  \"drones\": %d,\n",
+        Width, Height, Escape(AAMode).c_str(), DynamicResolution ? "true" : "false", Drones);
+    out << line;
+    std::snprintf(line, sizeof(line), "  \"frames\": %zu,\n  \"load_ms\": %.1f,\n  \"peak_rss_mb\": %.1f,\n  \"render_target_mb\": %.1f,\n",
+        Frames.size(), LoadMs, PeakRssMb, RenderTargetMb);
+    out << line;
+
+    out << "  \"overall\":\n";
+    WriteGroup(out, "    ", "overall", Frames, -1);
+    out << ",\n  \"segments\": [\n";
+    const std::vector<CameraPath::Segment>& segments = path.GetSegments();
+    for (size_t s = 0; s < segments.size(); s++) {
+        WriteGroup(out, "    ", segments[s].Name, Frames, static_cast<int>(s));
+        out << (s + 1 < segments.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    std::cout << "Benchmark: " << Frames.size() << " frames of " << path.GetName() << " r" << path.GetRevision()
+              << " written to " << file << std::endl;
+    return true;
+}
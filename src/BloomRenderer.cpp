@@ -0,0 +1,85 @@
+#include "BloomRenderer.h"
+#include "GpuProfiler.h"
+#include "RenderStats.h"
+#include <algorithm>
+#include <iostream>
+
+BloomRenderer::BloomRenderer(int mipCount)
+    : DownsampleShader(nullptr), UpsampleShader(nullptr), maxMips(mipCount), lastMipCount(0)
+{
+    DownsampleShader = new Shader("shaders/screen.vs", "shaders/bloom_downsample.fs");
+    UpsampleShader = new Shader("shaders/screen.vs", "shaders/bloom_upsample.fs");
+}
+
+BloomRenderer::~BloomRenderer() {
+    delete DownsampleShader;
+    delete UpsampleShader;
+}
+
+void BloomRenderer::Render(RenderTargetPool& pool, unsigned int sourceTexture, Framebuffer* output, unsigned int quadVAO) {
+    mips.clear();
+    if (output->Width < 2 || output->Height < 2) {
+        lastMipCount = 0;
+        return;
+    }
+    mips.push_back(output);
+    // Same format as the output (R11F_G11F_B10F: HDR range at half the bandwidth of RGB16F)
+    RenderTargetDesc desc;
+    desc.Format = output->InternalFormat;
+    desc.Width = output->Width;
+    desc.Height = output->Height;
+    for (int i = 1; i < maxMips; i++) {
+        desc.Width /= 2;
+        desc.Height /= 2;
+        if (desc.Width < 2 || desc.Height < 2) break; // Tiny windows get a shorter chain
+        mips.push_back(pool.Acquire(desc));
+    }
+    lastMipCount = static_cast<int>(mips.size());
+
+    glBindVertexArray(quadVAO);
+    glActiveTexture(GL_TEXTURE0);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    // 1. Downsample: source -> mip 0 -> ... -> mip N-1
+    // Each pass writes every texel, so no clear is needed
+    GpuProfiler::Begin("Downsample");
+    DownsampleShader->use();
+    DownsampleShader->setInt("srcTexture", 0);
+    DownsampleShader->setFloat("threshold", Threshold);
+    DownsampleShader->setFloat("knee", Knee);
+    unsigned int src = sourceTexture;
+    for (size_t i = 0; i < mips.size(); i++) {
+        // Threshold and firefly suppression only on the first (full -> half) pass
+        DownsampleShader->setBool("firstPass", i == 0);
+        mips[i]->Bind();
+        glBindTexture(GL_TEXTURE_2D, src);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        RenderStats::AddDraw(2);
+        src = mips[i]->TextureID;
+    }
+    GpuProfiler::End();
+
+    // 2. Upsample: mip N-1 -> ... -> mip 0, each level added onto the next larger one
+    GpuProfiler::Begin("Upsample");
+    UpsampleShader->use();
+    UpsampleShader->setInt("srcTexture", 0);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+    glBlendEquation(GL_FUNC_ADD);
+    for (size_t i = mips.size() - 1; i > 0; i--) {
+        const Framebuffer* small = mips[i];
+        UpsampleShader->setVec2("texelSize", FilterRadius / small->Width, FilterRadius / small->Height);
+        mips[i - 1]->Bind();
+        glBindTexture(GL_TEXTURE_2D, small->TextureID);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        RenderStats::AddDraw(2);
+        // Fully consumed: the next (larger) level or another pass can reuse it
+        pool.Release(mips[i]);
+    }
+    glDisable(GL_BLEND);
+    GpuProfiler::End();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    mips.clear();
+}
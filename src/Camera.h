@@ -42,6 +42,9 @@ public:
     float MouseSensitivity;
     float Zoom;
 
+    // [New] Sub-pixel projection offset in NDC (TAA jitter, zero when unused)
+    glm::vec2 Jitter = glm::vec2(0.0f);
+
     // 캯
     Camera(glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH)
         : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
@@ -57,6 +60,17 @@ public:
         return glm::lookAt(Position, Position + Front, Up);
     }
 
+    // [New] Projection , with the jitter applied (shifts the image by Jitter in NDC)
+    glm::mat4 GetProjectionMatrix(float aspect, float nearPlane, float farPlane, bool withJitter = true) const {
+        glm::mat4 projection = glm::perspective(glm::radians(Zoom), aspect, nearPlane, farPlane);
+        if (withJitter) {
+            // ndc = clip / -z, so the z column carries a constant screen offset
+            projection[2][0] -= Jitter.x;
+            projection[2][1] -= Jitter.y;
+        }
+        return projection;
+    }
+
     //  (WASD)
     void ProcessKeyboard(Camera_Movement direction, float deltaTime) {
         float velocity = MovementSpeed * deltaTime;
@@ -96,6 +110,14 @@ public:
         updateCameraVectors();
     }
 
+    // [New] Place the camera directly (scripted benchmark paths)
+    void SetPose(const glm::vec3& position, float yaw, float pitch) {
+        Position = position;
+        Yaw = yaw;
+        Pitch = pitch;
+        updateCameraVectors();
+    }
+
     // / (۱佹)
     void ProcessZoom(float yoffset) {
         Zoom -= (float)yoffset;
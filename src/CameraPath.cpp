@@ -0,0 +1,127 @@
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+// FNV-1a over the file bytes: identifies the exact path a result was measured on
+static uint64_t HashBytes(const std::string& data) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+template <typename T>
+static T CatmullRom(const T& p0, const T& p1, const T& p2, const T& p3, float t) {
+    float t2 = t * t, t3 = t2 * t;
+    return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+bool CameraPath::Load(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string content = buffer.str();
+
+    name.clear();
+    revision = 0;
+    frameCount = 0;
+    keys.clear();
+    segments.clear();
+    hash = HashBytes(content);
+
+    std::istringstream lines(content);
+    std::string line;
+    int lineNumber = 0;
+    bool sawHeader = false;
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream in(line);
+        std::string word;
+        if (!(in >> word)) continue;
+
+        auto fail = [&](const std::string& what) {
+            error = path + ":" + std::to_string(lineNumber) + ": " + what;
+            return false;
+        };
+
+        if (!sawHeader) {
+            int version = 0;
+            if (word != "cgtp-camera-path" || !(in >> version)) return fail("missing 'cgtp-camera-path <version>' header");
+            if (version != FORMAT_VERSION) return fail("unsupported format version " + std::to_string(version));
+            sawHeader = true;
+        } else if (word == "name") {
+            in >> name;
+        } else if (word == "revision") {
+            if (!(in >> revision)) return fail("bad revision");
+        } else if (word == "frames") {
+            if (!(in >> frameCount) || frameCount < 2) return fail("bad frame count");
+        } else if (word == "segment") {
+            Segment segment;
+            if (!(in >> segment.Name)) return fail("segment without a name");
+            segment.StartTime = -1.0f; // Set by its first key
+            segments.push_back(segment);
+        } else if (word == "key") {
+            Key key;
+            Pose& p = key.Value;
+            if (!(in >> key.Time >> p.Position.x >> p.Position.y >> p.Position.z >> p.Yaw >> p.Pitch >> p.Zoom))
+                return fail("expected 'key <time> <x> <y> <z> <yaw> <pitch> <zoom>'");
+            if (!keys.empty() && key.Time <= keys.back().Time) return fail("key times must increase");
+            if (segments.empty()) segments.push_back({ "path", key.Time });
+            if (segments.back().StartTime < 0.0f) segments.back().StartTime = key.Time;
+            keys.push_back(key);
+        } else {
+            return fail("unknown directive '" + word + "'");
+        }
+    }
+
+    if (!sawHeader) {
+        error = path + ": empty file";
+        return false;
+    }
+    if (keys.size() < 2) {
+        error = path + ": needs at least two keys";
+        return false;
+    }
+    segments.erase(std::remove_if(segments.begin(), segments.end(), [](const Segment& s) { return s.StartTime < 0.0f; }), segments.end());
+    if (name.empty()) name = "unnamed";
+    if (frameCount == 0) frameCount = static_cast<int>(GetDuration() * 60.0f) + 1;
+    return true;
+}
+
+CameraPath::Pose CameraPath::Evaluate(float time) const {
+    time = std::min(std::max(time, keys.front().Time), keys.back().Time);
+    // Last key at or before time
+    size_t i = 0;
+    while (i + 2 < keys.size() && keys[i + 1].Time <= time) i++;
+
+    const Key& k0 = keys[i > 0 ? i - 1 : i];
+    const Key& k1 = keys[i];
+    const Key& k2 = keys[i + 1];
+    const Key& k3 = keys[i + 2 < keys.size() ? i + 2 : i + 1];
+    float t = (time - k1.Time) / (k2.Time - k1.Time);
+
+    Pose pose;
+    pose.Position = CatmullRom(k0.Value.Position, k1.Value.Position, k2.Value.Position, k3.Value.Position, t);
+    pose.Yaw = CatmullRom(k0.Value.Yaw, k1.Value.Yaw, k2.Value.Yaw, k3.Value.Yaw, t);
+    pose.Pitch = std::min(std::max(CatmullRom(k0.Value.Pitch, k1.Value.Pitch, k2.Value.Pitch, k3.Value.Pitch, t), -89.0f), 89.0f);
+    // The spline may overshoot between keys; stay within what the game allows
+    pose.Zoom = std::min(std::max(CatmullRom(k0.Value.Zoom, k1.Value.Zoom, k2.Value.Zoom, k3.Value.Zoom, t), 1.0f), 90.0f);
+    return pose;
+}
+
+int CameraPath::SegmentAt(float time) const {
+    int index = 0;
+    for (int s = 1; s < static_cast<int>(segments.size()); s++)
+        if (segments[s].StartTime <= time) index = s;
+    return index;
+}
@@ -0,0 +1,288 @@
+#include "DroneSwarm.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+const size_t MIN_DRONES_PER_TASK = 512;   // Below this a task costs more than it saves
+const float OBSTACLE_MARGIN = 2.0f;       // Start steering this far from a wall
+const float MAX_STEP_DT = 0.1f;           // Keeps catch-up steps stable when over budget
+}
+
+DroneSwarm::DroneSwarm()
+    : obstacleOrigin(0.0f), obstacleCellSize(16.0f), obstacleCols(0), obstacleRows(0),
+      neighborDims(1), neighborOrigin(0.0f), neighborCellSize(1.0f),
+      simTime(0.0f), cursor(0), dronesPerFrame(SIZE_MAX), frameSteps(1), frameStep(1), frameMs(0.0f), frameStepped(0),
+      lastUpdateMs(0.0f), lastStepped(0), threadCount(1)
+{
+}
+
+void DroneSwarm::SetObstacles(const std::vector<AABB>& boxes) {
+    obstacles = boxes;
+    obstacleBuckets.clear();
+    obstacleCols = obstacleRows = 0;
+    if (obstacles.empty()) return;
+
+    // Coarse XZ buckets: buildings are tall, so the vertical axis is not worth splitting
+    AABB all;
+    for (const AABB& b : obstacles) {
+        all.Expand(b.Min);
+        all.Expand(b.Max);
+    }
+    obstacleOrigin = glm::vec2(all.Min.x, all.Min.z) - OBSTACLE_MARGIN;
+    obstacleCols = static_cast<int>((all.Max.x - all.Min.x + 2.0f * OBSTACLE_MARGIN) / obstacleCellSize) + 1;
+    obstacleRows = static_cast<int>((all.Max.z - all.Min.z + 2.0f * OBSTACLE_MARGIN) / obstacleCellSize) + 1;
+    obstacleBuckets.resize(obstacleCols * obstacleRows);
+
+    for (unsigned int i = 0; i < obstacles.size(); i++) {
+        const AABB& b = obstacles[i];
+        int x0 = static_cast<int>((b.Min.x - OBSTACLE_MARGIN - obstacleOrigin.x) / obstacleCellSize);
+        int x1 = static_cast<int>((b.Max.x + OBSTACLE_MARGIN - obstacleOrigin.x) / obstacleCellSize);
+        int z0 = static_cast<int>((b.Min.z - OBSTACLE_MARGIN - obstacleOrigin.y) / obstacleCellSize);
+        int z1 = static_cast<int>((b.Max.z + OBSTACLE_MARGIN - obstacleOrigin.y) / obstacleCellSize);
+        for (int z = std::max(z0, 0); z <= std::min(z1, obstacleRows - 1); z++)
+            for (int x = std::max(x0, 0); x <= std::min(x1, obstacleCols - 1); x++)
+                obstacleBuckets[z * obstacleCols + x].push_back(i);
+    }
+}
+
+void DroneSwarm::RandomDrone(std::mt19937& rng, glm::vec3& outPosition, glm::vec3& outVelocity) const {
+    auto frand = [&rng]() { return (rng() % 10000) / 10000.0f; };
+
+    glm::vec3 extent = BoundsMax - BoundsMin;
+    for (int attempt = 0; attempt < 8; attempt++) {
+        outPosition = BoundsMin + glm::vec3(frand(), frand(), frand()) * extent;
+        glm::vec3 push = AvoidObstacles(outPosition);
+        if (glm::dot(push, push) == 0.0f) break;
+    }
+
+    float angle = frand() * glm::two_pi<float>();
+    outVelocity = glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * (0.5f * (MinSpeed + MaxSpeed));
+}
+
+glm::vec3 DroneSwarm::AvoidObstacles(const glm::vec3& p) const {
+    glm::vec3 push(0.0f);
+
+    // Soft walls at the swarm bounds
+    for (int a = 0; a < 3; a++) {
+        if (p[a] < BoundsMin[a] + OBSTACLE_MARGIN) push[a] += (BoundsMin[a] + OBSTACLE_MARGIN - p[a]);
+        if (p[a] > BoundsMax[a] - OBSTACLE_MARGIN) push[a] -= (p[a] - (BoundsMax[a] - OBSTACLE_MARGIN));
+    }
+
+    if (obstacleBuckets.empty()) return push;
+    int x = static_cast<int>((p.x - obstacleOrigin.x) / obstacleCellSize);
+    int z = static_cast<int>((p.z - obstacleOrigin.y) / obstacleCellSize);
+    if (x < 0 || z < 0 || x >= obstacleCols || z >= obstacleRows) return push;
+
+    // Buildings: push out horizontally, proportional to how deep the drone is in the margin
+    for (unsigned int i : obstacleBuckets[z * obstacleCols + x]) {
+        const AABB& b = obstacles[i];
+        if (p.y > b.Max.y + OBSTACLE_MARGIN) continue; // Flying over the roof
+        glm::vec2 lo(b.Min.x - OBSTACLE_MARGIN, b.Min.z - OBSTACLE_MARGIN);
+        glm::vec2 hi(b.Max.x + OBSTACLE_MARGIN, b.Max.z + OBSTACLE_MARGIN);
+        if (p.x < lo.x || p.x > hi.x || p.z < lo.y || p.z > hi.y) continue;
+
+        float dl = p.x - lo.x, dr = hi.x - p.x, db = p.z - lo.y, df = hi.y - p.z;
+        float m = std::min(std::min(dl, dr), std::min(db, df));
+        if (m == dl) push.x -= dl;
+        else if (m == dr) push.x += dr;
+        else if (m == db) push.z -= db;
+        else push.z += df;
+    }
+    return push;
+}
+
+glm::vec3 DroneSwarm::PatrolGoal(unsigned int slot) const {
+    // Four groups orbiting the bounds center on phase-shifted loops
+    float phase = (slot % 4) * glm::half_pi<float>();
+    glm::vec3 center = (BoundsMin + BoundsMax) * 0.5f;
+    glm::vec3 half = (BoundsMax - BoundsMin) * 0.5f;
+    return center + glm::vec3(half.x * 0.6f * std::cos(simTime * 0.1f + phase),
+                              half.y * 0.3f * std::sin(simTime * 0.17f + phase),
+                              half.z * 0.6f * std::sin(simTime * 0.1f + phase));
+}
+
+glm::ivec3 DroneSwarm::NeighborCell(const glm::vec3& p) const {
+    glm::ivec3 c = glm::ivec3(glm::floor((p - neighborOrigin) / neighborCellSize));
+    return glm::clamp(c, glm::ivec3(0), neighborDims - 1); // Strays share the border cells
+}
+
+void DroneSwarm::BuildNeighborGrid(const TargetPool& pool) {
+    CGTP_PROFILE_FUNCTION();
+    const size_t n = pool.Size();
+    neighborCellSize = std::max(NeighborRadius, 0.5f);
+    neighborOrigin = BoundsMin - glm::vec3(neighborCellSize);
+    neighborDims = glm::max(glm::ivec3(glm::ceil((BoundsMax - BoundsMin) / neighborCellSize)) + 2, glm::ivec3(1));
+    const size_t cellCount = static_cast<size_t>(neighborDims.x) * neighborDims.y * neighborDims.z;
+
+    // Counting sort by cell: count, prefix sum, scatter
+    cellStart.assign(cellCount + 1, 0);
+    cellOfDrone.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        glm::ivec3 c = NeighborCell(pool.PositionAt(i));
+        unsigned int cell = (c.z * neighborDims.y + c.y) * neighborDims.x + c.x;
+        cellOfDrone[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; c++)
+        cellStart[c + 1] += cellStart[c];
+
+    sortedPosX.resize(n); sortedPosY.resize(n); sortedPosZ.resize(n);
+    sortedVelX.resize(n); sortedVelY.resize(n); sortedVelZ.resize(n);
+    cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        unsigned int dst = cellFill[cellOfDrone[i]]++;
+        sortedPosX[dst] = pool.PosX[i]; sortedPosY[dst] = pool.PosY[i]; sortedPosZ[dst] = pool.PosZ[i];
+        sortedVelX[dst] = pool.VelX[i]; sortedVelY[dst] = pool.VelY[i]; sortedVelZ[dst] = pool.VelZ[i];
+    }
+}
+
+void DroneSwarm::StepRange(const TargetPool& pool, size_t begin, size_t end, float dt) {
+    CGTP_PROFILE_FUNCTION();
+    const float* px = sortedPosX.data();
+    const float* py = sortedPosY.data();
+    const float* pz = sortedPosZ.data();
+    const float* vx = sortedVelX.data();
+    const float* vy = sortedVelY.data();
+    const float* vz = sortedVelZ.data();
+    const float sepR2 = SeparationRadius * SeparationRadius;
+    const float nbrR2 = NeighborRadius * NeighborRadius;
+
+    glm::vec3 goals[4];
+    for (unsigned int g = 0; g < 4; g++) goals[g] = PatrolGoal(g);
+
+    for (size_t i = begin; i < end; i++) {
+        glm::vec3 p = pool.PositionAt(i);
+        glm::vec3 v = pool.VelocityAt(i);
+        glm::ivec3 c = NeighborCell(p);
+
+        glm::vec3 separation(0.0f), alignment(0.0f), cohesion(0.0f);
+        int count = 0;
+        for (int dz = -1; dz <= 1 && count < MaxNeighbors; dz++) {
+            int z = c.z + dz;
+            if (z < 0 || z >= neighborDims.z) continue;
+            for (int dy = -1; dy <= 1 && count < MaxNeighbors; dy++) {
+                int y = c.y + dy;
+                if (y < 0 || y >= neighborDims.y) continue;
+                // The three x-neighbours are adjacent in memory: one contiguous run
+                int x0 = std::max(c.x - 1, 0), x1 = std::min(c.x + 1, neighborDims.x - 1);
+                unsigned int row = (z * neighborDims.y + y) * neighborDims.x;
+                for (unsigned int j = cellStart[row + x0]; j < cellStart[row + x1 + 1]; j++) {
+                    glm::vec3 d(p.x - px[j], p.y - py[j], p.z - pz[j]);
+                    float dist2 = glm::dot(d, d);
+                    if (dist2 > nbrR2 || dist2 == 0.0f) continue; // Out of range, or this drone
+                    if (dist2 < sepR2)
+                        separation += d / std::max(dist2, 1e-3f);
+                    alignment += glm::vec3(vx[j], vy[j], vz[j]);
+                    cohesion += glm::vec3(px[j], py[j], pz[j]);
+                    if (++count >= MaxNeighbors) break;
+                }
+            }
+        }
+
+        glm::vec3 steer = AvoidWeight * AvoidObstacles(p);
+        if (count > 0) {
+            float inv = 1.0f / count;
+            steer += SeparationWeight * separation;
+            steer += AlignmentWeight * (alignment * inv - v);
+            steer += CohesionWeight * (cohesion * inv - p);
+        }
+        glm::vec3 toGoal = goals[pool.SlotAt(i) % 4] - p;
+        float goalLen = glm::length(toGoal);
+        if (goalLen > 1e-3f) steer += GoalWeight * MaxSpeed * (toGoal / goalLen);
+
+        v += steer * dt;
+        float speed = glm::length(v);
+        if (speed > MaxSpeed) v *= MaxSpeed / speed;
+        else if (speed < MinSpeed && speed > 1e-4f) v *= MinSpeed / speed;
+
+        p += v * dt;
+        nextPosX[i] = p.x; nextPosY[i] = p.y; nextPosZ[i] = p.z;
+        nextVelX[i] = v.x; nextVelY[i] = v.y; nextVelZ[i] = v.z;
+    }
+}
+
+void DroneSwarm::BeginFrame(int steps) {
+    frameSteps = std::max(1, steps);
+    frameStep = 0;
+    frameMs = 0.0f;
+    frameStepped = 0;
+    lastUpdateMs = 0.0f;
+    lastStepped = 0;
+}
+
+void DroneSwarm::Update(TargetPool& pool, TargetGrid& grid, float deltaTime) {
+    if (frameStep >= frameSteps)
+        BeginFrame(1);
+    const int stepsLeft = frameSteps - frameStep++;
+    const size_t n = pool.Size();
+    if (n == 0 || deltaTime <= 0.0f) return;
+
+    simTime += deltaTime;
+    // The frame's budget is spent: its remaining steps leave the drones where they are
+    if (frameMs >= BudgetMs) return;
+
+    CGTP_PROFILE_SCOPE("DroneSwarm::Update");
+    auto start = std::chrono::high_resolution_clock::now();
+
+    nextPosX.resize(n); nextPosY.resize(n); nextPosZ.resize(n);
+    nextVelX.resize(n); nextVelY.resize(n); nextVelZ.resize(n);
+    BuildNeighborGrid(pool);
+
+    // Over budget only a window of drones is stepped, round-robin, with a proportionally larger dt.
+    // The frame's steps split its window
+    size_t allowance = dronesPerFrame > frameStepped ? dronesPerFrame - frameStepped : 0;
+    size_t k = std::min(n, std::max(MIN_DRONES_PER_TASK, allowance / stepsLeft));
+    float stepDt = std::min(deltaTime * static_cast<float>(n) / static_cast<float>(k), MAX_STEP_DT);
+    if (cursor >= n) cursor = 0;
+
+    windows.clear();
+    windows.push_back({ cursor, std::min(n, cursor + k) });
+    if (cursor + k > n) windows.push_back({ 0, cursor + k - n });
+
+    // Split the window into one task per job thread (each at least MIN_DRONES_PER_TASK)
+    threadCount = JobSystem::GetThreadCount();
+    tasks.clear();
+    size_t perTask = std::max(MIN_DRONES_PER_TASK, (k + threadCount - 1) / threadCount);
+    for (const Range& w : windows)
+        for (size_t b = w.begin; b < w.end; b += perTask)
+            tasks.push_back({ b, std::min(w.end, b + perTask) });
+
+    JobSystem::Counter done;
+    for (size_t t = 1; t < tasks.size(); t++)
+        JobSystem::Run([this, &pool, t, stepDt]() {
+            StepRange(pool, tasks[t].begin, tasks[t].end, stepDt);
+        }, &done);
+    StepRange(pool, tasks[0].begin, tasks[0].end, stepDt);
+    JobSystem::Wait(done);
+
+    // Commit on this thread: columns first, then the grid (Move is O(1), relinks only on cell change)
+    for (const Range& w : windows) {
+        for (size_t i = w.begin; i < w.end; i++) {
+            pool.PosX[i] = nextPosX[i]; pool.PosY[i] = nextPosY[i]; pool.PosZ[i] = nextPosZ[i];
+            pool.VelX[i] = nextVelX[i]; pool.VelY[i] = nextVelY[i]; pool.VelZ[i] = nextVelZ[i];
+            grid.Move(pool.SlotAt(i), glm::vec3(nextPosX[i], nextPosY[i], nextPosZ[i]));
+        }
+    }
+    cursor = (cursor + k) % n;
+
+    auto end = std::chrono::high_resolution_clock::now();
+    frameMs += std::chrono::duration<float, std::milli>(end - start).count();
+    frameStepped += k;
+    lastUpdateMs = frameMs;
+    lastStepped = frameStepped;
+    if (frameStep < frameSteps) return;
+
+    // Last step of the frame: adapt the window to the budget, shrink fast, grow slowly
+    if (frameMs > BudgetMs)
+        dronesPerFrame = std::max<size_t>(MIN_DRONES_PER_TASK, static_cast<size_t>(frameStepped * 0.9f * BudgetMs / frameMs));
+    else if (frameStepped < n * frameSteps)
+        dronesPerFrame = frameStepped + frameStepped / 10 + 64;
+    else
+        dronesPerFrame = SIZE_MAX;
+}
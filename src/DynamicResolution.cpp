@@ -0,0 +1,43 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution() : scale(1.0f), lastGpuMs(0.0f), framesSinceChange(0), changeCount(0) {
+}
+
+float DynamicResolution::Quantize(float value) const {
+    // Round down: a slightly smaller target is better than missing the budget
+    float q = Step > 0.0f ? std::floor(value / Step + 1e-3f) * Step : value;
+    return std::min(std::max(q, MinScale), MaxScale);
+}
+
+float DynamicResolution::Update(float gpuMs) {
+    lastGpuMs = gpuMs;
+    framesSinceChange++;
+    if (!Enabled || gpuMs <= 0.0f) return GetScale();
+
+    // Bounds changed in the UI: apply right away
+    if (scale < MinScale || scale > MaxScale) {
+        scale = Quantize(scale);
+        framesSinceChange = 0;
+        return scale;
+    }
+    if (framesSinceChange < SettleFrames) return scale;
+
+    float next = scale;
+    if (gpuMs > TargetMs) {
+        // Over budget: aim a bit below the target so the next frame does not hover at the edge
+        next = Quantize(scale * std::sqrt(TargetMs * 0.95f / gpuMs));
+    } else if (gpuMs < TargetMs * 0.8f) {
+        // Clear headroom: grow at most two steps at a time
+        float grown = scale * std::sqrt(TargetMs * 0.9f / gpuMs);
+        next = Quantize(std::min(grown, scale + 2.0f * Step));
+    }
+
+    if (next != scale) {
+        scale = next;
+        framesSinceChange = 0;
+        changeCount++;
+    }
+    return scale;
+}
@@ -0,0 +1,30 @@
+#include "FixedTimestep.h"
+#include <cmath>
+
+int FixedTimestep::Advance(double frameSeconds) {
+    if (frameSeconds > 0.0)
+        accumulator += frameSeconds;
+    int steps = 0;
+    while (accumulator >= Step && steps < MaxSteps) {
+        accumulator -= Step;
+        steps++;
+    }
+    if (accumulator >= Step) {
+        // Over the cap: keep the fraction, drop the whole steps
+        double fraction = std::fmod(accumulator, Step);
+        droppedTime += accumulator - fraction;
+        accumulator = fraction;
+    }
+    simulatedTime += steps * Step;
+    stepCount += steps;
+    lastSteps = steps;
+    return steps;
+}
+
+void FixedTimestep::Reset() {
+    accumulator = 0.0;
+    simulatedTime = 0.0;
+    droppedTime = 0.0;
+    stepCount = 0;
+    lastSteps = 0;
+}
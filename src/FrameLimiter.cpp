@@ -0,0 +1,53 @@
+#include "FrameLimiter.h"
+#include "Profiler.h"
+
+static const GLuint64 WAIT_TIMEOUT_NS = 100000000; // Per glClientWaitSync call; retried
+
+FrameLimiter::FrameLimiter()
+    : oldest(0), count(0), frame(0), completedFrame(0), lastWaitMs(0.0f) {
+}
+
+void FrameLimiter::Wait() {
+    CGTP_PROFILE_SCOPE("Frame Limiter");
+    auto start = Clock::now();
+    // Already finished: no flush, no wait
+    while (count > 0 && glClientWaitSync(fences[oldest].Sync, 0, 0) != GL_TIMEOUT_EXPIRED)
+        Retire();
+
+    int limit = RING_SIZE; // No cap: fences only
+    if (MaxFramesInFlight > 0)
+        limit = MaxFramesInFlight < MAX_FRAMES_IN_FLIGHT ? MaxFramesInFlight : int(MAX_FRAMES_IN_FLIGHT);
+    while (count >= limit) {
+        // Flush once, or a fence still sitting in the command queue would never signal
+        GLenum result = glClientWaitSync(fences[oldest].Sync, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT_NS);
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fences[oldest].Sync, 0, WAIT_TIMEOUT_NS);
+        Retire(); // GL_WAIT_FAILED too: never wait on that fence again
+    }
+    lastWaitMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+unsigned long long FrameLimiter::Submit() {
+    if (count == RING_SIZE)
+        Wait(); // Only when Wait was skipped
+    Fence& fence = fences[(oldest + count) % RING_SIZE];
+    fence.Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    fence.Frame = ++frame;
+    count++;
+    return frame;
+}
+
+void FrameLimiter::Release() {
+    for (; count > 0; count--) {
+        glDeleteSync(fences[oldest].Sync);
+        oldest = (oldest + 1) % RING_SIZE;
+    }
+}
+
+void FrameLimiter::Retire() {
+    glDeleteSync(fences[oldest].Sync);
+    completedFrame = fences[oldest].Frame;
+    completedTime = Clock::now();
+    oldest = (oldest + 1) % RING_SIZE;
+    count--;
+}
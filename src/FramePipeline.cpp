@@ -0,0 +1,96 @@
+#include "FramePipeline.h"
+#include "Profiler.h"
+
+#include <chrono>
+
+FramePipeline::FramePipeline()
+    : front(0), busy(false), pending(false), quit(false), lastBuildMs(0.0f), lastWaitMs(0.0f), frame(0) {
+}
+
+FramePipeline::~FramePipeline() {
+    Stop();
+}
+
+void FramePipeline::Start(BuildFn buildFn) {
+    Stop();
+    build = buildFn;
+    quit = false;
+    thread = std::thread(&FramePipeline::ThreadLoop, this);
+}
+
+void FramePipeline::Stop() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+    }
+    wake.notify_one();
+    thread.join(); // Finishes a queued build first
+}
+
+void FramePipeline::Flush() {
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this]() { return !busy; });
+    }
+    lastWaitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+const RenderPacket& FramePipeline::Exchange(FrameInput&& input, const IdleFn& betweenBuilds) {
+    Flush();
+    const bool threaded = Threaded && thread.joinable();
+    bool built = false;
+    if (pending) {
+        front = 1 - front; // The packet built during the last frame
+        pending = false;
+        built = true;
+    }
+    FrameInput next;
+    if (!threaded || !built) {
+        // Inline, or nothing was in flight (first frame, or Threaded just turned on): build
+        // from this input now; in threaded mode an empty input (no events, no time, so no
+        // steps) then gets the pipeline going
+        BuildBack(input);
+        front = 1 - front;
+        next.Time = input.Time;
+        next.LookTotal = input.LookTotal;
+    } else {
+        next = std::move(input);
+    }
+    if (betweenBuilds)
+        betweenBuilds(packets[front]);
+    if (threaded) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            work = std::move(next);
+            busy = pending = true;
+        }
+        wake.notify_one();
+    }
+    return packets[front];
+}
+
+void FramePipeline::BuildBack(const FrameInput& input) {
+    CGTP_PROFILE_SCOPE("Build Frame");
+    auto start = std::chrono::steady_clock::now();
+    RenderPacket& packet = packets[1 - front];
+    build(input, packet);
+    packet.Frame = ++frame;
+    lastBuildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FramePipeline::ThreadLoop() {
+    CGTP_PROFILE_THREAD("Game");
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        wake.wait(guard, [this]() { return busy || quit; });
+        if (!busy) break;
+        FrameInput input = std::move(work);
+        guard.unlock();
+        BuildBack(input);
+        guard.lock();
+        busy = false;
+        done.notify_all();
+    }
+}
@@ -0,0 +1,149 @@
+#include "FrameStats.h"
+#include "GpuProfiler.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static const float BIN_MS = 0.1f;
+
+FrameStats::FrameStats() : recentNext(0), recentMedian(0.0f), pendingCapture(-1), captureHitch(0), lastCaptureTime(-1e9), elapsed(0.0) {
+    Reset();
+}
+
+void FrameStats::Reset() {
+    cpu = Histogram();
+    gpu = Histogram();
+    cpu.Bins.assign(BIN_COUNT, 0);
+    gpu.Bins.assign(BIN_COUNT, 0);
+    recent.clear();
+    recentNext = 0;
+    recentMedian = 0.0f;
+    pendingCapture = -1;
+    lastCaptureTime = -1e9;
+    elapsed = 0.0;
+    hitches.clear();
+}
+
+void FrameStats::Add(Histogram& h, float ms) {
+    int bin = std::min(static_cast<int>(ms / BIN_MS), BIN_COUNT - 1);
+    h.Bins[std::max(bin, 0)]++;
+    h.Count++;
+    h.Sum += ms;
+    h.Max = std::max(h.Max, ms);
+    if (ms > BudgetMs) h.OverBudget++;
+}
+
+void FrameStats::AddCpuFrame(float ms) {
+    Add(cpu, ms);
+    elapsed += ms / 1000.0;
+
+    // The frame that wrote a capture is slow because of it: save, then skip detection once
+    bool justCaptured = false;
+    if (pendingCapture >= 0 && pendingCapture-- == 0) {
+        SaveHitchCapture();
+        justCaptured = true;
+    }
+
+    // Hitch test against the median of the frames before this one
+    if (!justCaptured && static_cast<int>(recent.size()) == RECENT_FRAMES
+        && ms > HitchFactor * recentMedian && ms > HitchMinMs) {
+        Hitch hitch;
+        hitch.Frame = cpu.Count;
+        hitch.Ms = ms;
+        hitch.MedianMs = recentMedian;
+        hitches.push_back(hitch);
+        // Wait until the GPU profiler has read this frame back
+        if (CaptureHitches && pendingCapture < 0 && elapsed - lastCaptureTime >= HitchCooldown) {
+            pendingCapture = GpuProfiler::FRAMES_IN_FLIGHT + 1;
+            captureHitch = hitches.size() - 1;
+        }
+    }
+
+    if (static_cast<int>(recent.size()) < RECENT_FRAMES) {
+        recent.push_back(ms);
+    } else {
+        recent[recentNext] = ms;
+        recentNext = (recentNext + 1) % RECENT_FRAMES;
+    }
+    sorted.assign(recent.begin(), recent.end());
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    recentMedian = sorted[sorted.size() / 2];
+}
+
+void FrameStats::AddGpuFrame(float ms) {
+    Add(gpu, ms);
+}
+
+void FrameStats::SaveHitchCapture() {
+    lastCaptureTime = elapsed;
+    Hitch& hitch = hitches[captureHitch];
+
+    std::error_code ec;
+    std::filesystem::create_directories(HitchDirectory, ec);
+    std::string base = HitchDirectory + "/hitch_" + std::to_string(hitch.Frame);
+    if (GpuProfiler::ExportChromeTrace(base + "_gpu.json"))
+        hitch.Files = base + "_gpu.json";
+    if (Profiler::CompiledIn && Profiler::SaveCapture(base + "_cpu.json"))
+        hitch.Files += (hitch.Files.empty() ? "" : " ") + base + "_cpu.json";
+    std::cout << "Hitch: frame " << hitch.Frame << " took " << hitch.Ms << " ms (median " << hitch.MedianMs
+              << " ms), saved " << (hitch.Files.empty() ? std::string("nothing") : hitch.Files) << std::endl;
+}
+
+FrameStats::Summary FrameStats::Summarize(const Histogram& h) const {
+    Summary s;
+    s.Frames = h.Count;
+    if (h.Count == 0) return s;
+    s.Max = h.Max;
+    s.Mean = static_cast<float>(h.Sum / h.Count);
+    s.OverBudget = h.OverBudget;
+
+    // Walk the cumulative counts once; a percentile is the center of its bin (never above the max)
+    const double ranks[3] = { 0.50, 0.95, 0.99 };
+    float* outs[3] = { &s.P50, &s.P95, &s.P99 };
+    long long cumulative = 0;
+    int r = 0;
+    for (int i = 0; i < BIN_COUNT && r < 3; i++) {
+        cumulative += h.Bins[i];
+        while (r < 3 && cumulative >= static_cast<long long>(ranks[r] * h.Count + 0.5)) {
+            *outs[r] = i == BIN_COUNT - 1 ? h.Max : std::min((i + 0.5f) * BIN_MS, h.Max);
+            r++;
+        }
+    }
+    return s;
+}
+
+static void WriteSummary(std::ofstream& out, const char* name, const FrameStats::Summary& s, bool last) {
+    char line[256];
+    std::snprintf(line, sizeof(line),
+        "  \"%s\": {\"frames\": %lld, \"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f, \"mean\": %.2f, \"over_budget\": %lld}%s\n",
+        name, s.Frames, s.P50, s.P95, s.P99, s.Max, s.Mean, s.OverBudget, last ? "" : ",");
+    out << line;
+}
+
+bool FrameStats::WriteJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::FRAME_STATS:: Cannot write " << path << std::endl;
+        return false;
+    }
+    char line[256];
+    out << "{\n";
+    std::snprintf(line, sizeof(line), "  \"budget_ms\": %.2f,\n  \"duration_s\": %.1f,\n", BudgetMs, elapsed);
+    out << line;
+    WriteSummary(out, "cpu_ms", GetCpuSummary(), false);
+    WriteSummary(out, "gpu_ms", GetGpuSummary(), false);
+    out << "  \"hitches\": [";
+    for (size_t i = 0; i < hitches.size(); i++) {
+        const Hitch& h = hitches[i];
+        std::snprintf(line, sizeof(line), "%s\n    {\"frame\": %lld, \"ms\": %.2f, \"median_ms\": %.2f, \"capture\": \"%s\"}",
+            i ? "," : "", h.Frame, h.Ms, h.MedianMs, h.Files.c_str());
+        out << line;
+    }
+    out << (hitches.empty() ? "]\n" : "\n  ]\n") << "}\n";
+    std::cout << "Frame stats: " << cpu.Count << " frames written to " << path << std::endl;
+    return true;
+}
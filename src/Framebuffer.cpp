@@ -1,21 +1,59 @@
 #include "Framebuffer.h"
 
-Framebuffer::Framebuffer(int width, int height, bool multisampled) 
-    : Width(width), Height(height), IsMultisampled(multisampled), ID(0), TextureID(0), RBO(0) {
+Framebuffer::Framebuffer(int width, int height, bool multisampled, GLenum internalFormat, bool withDepth, int samples, bool depthTexture)
+    : Width(width), Height(height), IsMultisampled(multisampled), InternalFormat(internalFormat), HasDepth(withDepth),
+      Samples(multisampled ? samples : 1), DepthIsTexture(withDepth && depthTexture && !multisampled),
+      ID(0), TextureID(0), RBO(0), DepthTextureID(0) {
     Init();
 }
 
+// Upload format/type matching an internal format (no data is uploaded, but GL validates the pair)
+static void PixelTransferFormat(GLenum internalFormat, GLenum& format, GLenum& type) {
+    switch (internalFormat) {
+    case GL_RGBA8:   format = GL_RGBA; type = GL_UNSIGNED_BYTE; break;
+    case GL_RGB8:    format = GL_RGB;  type = GL_UNSIGNED_BYTE; break;
+    case GL_RG8:     format = GL_RG;   type = GL_UNSIGNED_BYTE; break;
+    case GL_R8:      format = GL_RED;  type = GL_UNSIGNED_BYTE; break;
+    case GL_RGBA16F:
+    case GL_RGBA32F: format = GL_RGBA; type = GL_FLOAT; break;
+    case GL_RG16F:   format = GL_RG;   type = GL_FLOAT; break;
+    case GL_R16F:
+    case GL_R32F:    format = GL_RED;  type = GL_FLOAT; break;
+    default:         format = GL_RGB;  type = GL_FLOAT; break; // GL_RGB16F, GL_R11F_G11F_B10F, GL_RGB32F
+    }
+}
+
+static size_t BytesPerPixel(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_R8:              return 1;
+    case GL_RG8:
+    case GL_R16F:            return 2;
+    case GL_RGBA8:
+    case GL_RGB8:            // Padded to 4 bytes by every driver
+    case GL_R11F_G11F_B10F:
+    case GL_RG16F:
+    case GL_R32F:            return 4;
+    case GL_RGB16F:          // Usually stored as RGBA16F
+    case GL_RGBA16F:         return 8;
+    default:                 return 16;
+    }
+}
+
 Framebuffer::~Framebuffer() {
     glDeleteFramebuffers(1, &ID);
     glDeleteTextures(1, &TextureID);
-    glDeleteRenderbuffers(1, &RBO);
+    if (RBO) glDeleteRenderbuffers(1, &RBO);
+    if (DepthTextureID) glDeleteTextures(1, &DepthTextureID);
 }
 
 void Framebuffer::Init() {
     if (ID) {
         glDeleteFramebuffers(1, &ID);
         glDeleteTextures(1, &TextureID);
-        glDeleteRenderbuffers(1, &RBO);
+        if (RBO) glDeleteRenderbuffers(1, &RBO);
+        if (DepthTextureID) glDeleteTextures(1, &DepthTextureID);
+        RBO = 0;
+        DepthTextureID = 0;
     }
 
     glGenFramebuffers(1, &ID);
@@ -25,14 +63,14 @@ void Framebuffer::Init() {
     glGenTextures(1, &TextureID);
     if (IsMultisampled) {
         glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, TextureID);
-        // Use GL_RGB16F for HDR values
-        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, 4, GL_RGB16F, Width, Height, GL_TRUE); // 4x MSAA
+        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Samples, InternalFormat, Width, Height, GL_TRUE);
         glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, TextureID, 0);
     } else {
         glBindTexture(GL_TEXTURE_2D, TextureID);
-        // Use GL_RGB16F for internal format, GL_FLOAT for type
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, Width, Height, 0, GL_RGB, GL_FLOAT, NULL);
+        GLenum format, type;
+        PixelTransferFormat(InternalFormat, format, type);
+        glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, Width, Height, 0, format, type, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE); 
@@ -41,16 +79,28 @@ void Framebuffer::Init() {
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, TextureID, 0);
     }
 
-    // Create Depth/Stencil Attachment (Renderbuffer)
-    glGenRenderbuffers(1, &RBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-    if (IsMultisampled) {
-        glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8, Width, Height);
-    } else {
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, Width, Height);
+    // Create Depth/Stencil Attachment (Renderbuffer), only for targets that draw geometry
+    if (DepthIsTexture) {
+        glGenTextures(1, &DepthTextureID);
+        glBindTexture(GL_TEXTURE_2D, DepthTextureID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, Width, Height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, DepthTextureID, 0);
+    } else if (HasDepth) {
+        glGenRenderbuffers(1, &RBO);
+        glBindRenderbuffer(GL_RENDERBUFFER, RBO);
+        if (IsMultisampled) {
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, Samples, GL_DEPTH24_STENCIL8, Width, Height);
+        } else {
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, Width, Height);
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, RBO);
     }
-    glBindRenderbuffer(GL_RENDERBUFFER, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, RBO); // [Missing in previous code?]
 
     // [New] Check Framebuffer Status
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
@@ -87,3 +137,8 @@ void Framebuffer::Rescale(int width, int height) {
     Height = height;
     Init();
 }
+
+size_t Framebuffer::GetMemoryBytes() const {
+    size_t pixels = static_cast<size_t>(Width) * Height * Samples;
+    return pixels * BytesPerPixel(InternalFormat) + (HasDepth ? pixels * 4 : 0);
+}
@@ -1,29 +1,35 @@
 #include "GameManager.h"
-#include <glm/gtc/matrix_transform.hpp>
-#include <cstdlib>
+#include "Profiler.h"
 #include <ctime>
 #include <iostream>
 
-GameManager::GameManager() : timeLeft(0.0f), score(0), isGameOver(false), spawnTimer(0.0f), cubeVAO(0), cubeVBO(0) {
-    std::srand(static_cast<unsigned int>(std::time(0)));
-}
-
-GameManager::~GameManager() {
-    glDeleteVertexArrays(1, &cubeVAO);
-    glDeleteBuffers(1, &cubeVBO);
-}
-
-void GameManager::Init() {
-    InitRenderData();
-    StartGame();
+GameManager::GameManager() : timeLeft(0.0f), score(0), isGameOver(false), spawnTimer(0.0f), droneMode(false), droneCount(5000), seed(static_cast<uint32_t>(std::time(0))), targetGrid(8.0f, TARGET_RADIUS) {
 }
 
 void GameManager::StartGame() {
-    timeLeft = GAME_DURATION;
+    timeLeft = config.GameDuration;
     score = 0;
     isGameOver = false;
     spawnTimer = 0.0f;
-    targets.clear();
+    rng.seed(seed);
+    targets.Clear();
+    targetGrid.Clear();
+
+    // Drone mode starts with the whole flock in the air
+    if (droneMode) {
+        targets.Reserve(droneCount);
+        for (int i = 0; i < droneCount; i++) {
+            glm::vec3 position, velocity;
+            drones.RandomDrone(rng, position, velocity);
+            TargetHandle h = targets.Create(position, velocity);
+            targetGrid.Insert(h.slot, position);
+        }
+    }
+}
+
+void GameManager::SetDroneMode(bool enabled, int count) {
+    droneMode = enabled;
+    droneCount = count;
 }
 
 void GameManager::ResetGame() {
@@ -31,6 +37,7 @@ void GameManager::ResetGame() {
 }
 
 void GameManager::Update(float deltaTime) {
+    CGTP_PROFILE_SCOPE("GameManager::Update");
     if (isGameOver) return;
 
     timeLeft -= deltaTime;
@@ -40,11 +47,23 @@ void GameManager::Update(float deltaTime) {
         return;
     }
 
+    // Rendering interpolates from the state before this step
+    targets.SavePrevious();
+
+    // Age every target in one pass over the column
+    targets.Age(deltaTime);
+
+    if (droneMode) {
+        // Batched flocking kernel (parallel, budgeted); no static spawns in this mode
+        drones.Update(targets, targetGrid, deltaTime);
+        return;
+    }
+
     // Spawn Logic
     spawnTimer += deltaTime;
-    if (spawnTimer >= SPAWN_INTERVAL) {
+    if (spawnTimer >= config.SpawnInterval) {
         spawnTimer = 0.0f;
-        if (targets.size() < MAX_TARGETS) {
+        if (targets.Size() < static_cast<size_t>(config.MaxTargets)) {
             SpawnTarget();
         }
     }
@@ -57,19 +76,22 @@ void GameManager::SpawnTarget() {
     // Focus on Front-Left area (Negative X, Negative Z)
     // [Modified] Reduced range to keep targets within the map boundaries (-80 to -10)
     
-    Target t;
     // X: -80 to -10 (Closer to center)
-    float x = (std::rand() % 700) / 10.0f - 80.0f;
+    float x = (rng() % 700) / 10.0f - 80.0f;
     // Y: 10 to 50 (High rises)
-    float y = (std::rand() % 400) / 10.0f + 10.0f; 
+    float y = (rng() % 400) / 10.0f + 10.0f; 
     // Z: -100 to -20 (Closer to center)
-    float z = (std::rand() % 800) / 10.0f - 100.0f;
-    
-    t.position = glm::vec3(x, y, z);
-    t.isActive = true;
-    t.activeTime = 0.0f;
+    float z = (rng() % 800) / 10.0f - 100.0f;
     
-    targets.push_back(t);
+    glm::vec3 position(x, y, z);
+    TargetHandle h = targets.Create(position);
+    targetGrid.Insert(h.slot, position);
+}
+
+void GameManager::RemoveTarget(TargetHandle handle) {
+    // Pool swap-removes its columns; grid ids are slots, which never move
+    targetGrid.Remove(handle.slot);
+    targets.Destroy(handle);
 }
 
 bool GameManager::CheckShot(Camera& camera, bool& outHit) {
@@ -79,132 +101,50 @@ bool GameManager::CheckShot(Camera& camera, bool& outHit) {
     glm::vec3 rayOrigin = camera.Position;
     glm::vec3 rayDir = camera.Front;
 
-    for (auto it = targets.begin(); it != targets.end(); ) {
-        if (!it->isActive) {
-            ++it;
-            continue;
-        }
-
-        // 1. Ray Intersection (Simple Sphere Text against Cube center)
-        // Target visual size is roughly 0.5 unit radius
-        if (RaySphereIntersect(rayOrigin, rayDir, it->position, 0.8f)) {
-            
-            // 2. Distance Check
-            float dist = glm::distance(camera.Position, it->position);
-            
-            // 3. Zoom Requirement
-            if (dist > FAR_DISTANCE_THRESHOLD) {
-               if (camera.Zoom > REQUIRED_ZOOM) {
-                   // Hit valid, but not zoomed enough
-                   // Maybe give feedback? For now just fail the hit.
-                   ++it;
-                   continue;
-               }
+    // Zoom Requirement: without enough zoom only near targets count
+    float maxDistance = (camera.Zoom > config.RequiredZoom) ? config.FarDistanceThreshold : MAX_SHOT_DISTANCE;
+
+    int hitIndex = -1;
+    if (targets.Size() <= LINEAR_SCAN_LIMIT) {
+        // Few targets: one tight pass over the position columns
+        hitIndex = targets.RayScan(rayOrigin, rayDir, TARGET_RADIUS, maxDistance);
+    } else {
+        // Broad phase: only targets in the grid cells the ray passes through
+        targetGrid.RayQuery(rayOrigin, rayDir, maxDistance, queryScratch);
+
+        float hitDist = maxDistance;
+        for (unsigned int slot : queryScratch) {
+            uint32_t i = targets.DenseIndexOfSlot(slot);
+            if (!targets.IsActive[i]) continue;
+
+            // 1. Ray Intersection (Simple Sphere Text against Cube center)
+            glm::vec3 position = targets.PositionAt(i);
+            if (!RaySphereIntersect(rayOrigin, rayDir, position, TARGET_RADIUS)) continue;
+            if (glm::dot(position - rayOrigin, rayDir) < 0.0f) continue; // Behind the camera
+
+            // 2. Distance Check: single valid shot only hits one per click, keep the nearest
+            float dist = glm::distance(rayOrigin, position);
+            if (dist < hitDist) {
+                hitDist = dist;
+                hitIndex = static_cast<int>(i);
             }
-
-            // Hit Confirmed!
-            it = targets.erase(it);
-            score++;
-            outHit = true;
-            return true; // Single valid shot only hits one per click
-        } else {
-            ++it;
         }
     }
-    return false;
-}
 
-void GameManager::Render(Shader& shader) {
-    if (targets.empty() && isGameOver) return; // 'targets' not 'target'
+    if (hitIndex < 0) return false;
 
-    glBindVertexArray(cubeVAO);
-    
-    // We can reuse the same shader, but we need to set color uniforms
-    // If the shader is "textured.fs", it expects textures.
-    // We can just bind the white texture and set a specific "tint" or light color.
-    // Hacker way: Set lightDirection to be pure ambient or use a "isSolidColor" uniform if we added one.
-    // Or just draw them as "lights" (bright emission).
-    
-    // Assuming the shader used is `ourShader` (Textured).
-    // Let's rely on standard rendering but maybe toggle a "useTexture" uniform if it existed.
-    // Since we don't have that, we rely on the white texture we bound globally before this call?
-    // No, main loop binds textues.
-    
-    shader.setInt("objectType", 1); // [Added] Switch to Target Rendering Mode (Red Pulse)
-
-    for (const auto& t : targets) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, t.position);
-        model = glm::scale(model, glm::vec3(0.5f)); // Size
-        shader.setMat4("model", model);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
-    
-    shader.setInt("objectType", 0); // [Added] Reset just in case
+    // Hit Confirmed!
+    RemoveTarget(targets.HandleAt(hitIndex));
+    score++;
+    outHit = true;
+    return true;
 }
 
-void GameManager::InitRenderData() {
-    float vertices[] = {
-        // positions          // normals           // texture coords
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-        -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-         0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  1.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-         0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,
-         0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  1.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-         0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-        -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.0f,
-        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
-    };
-
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindVertexArray(cubeVAO);
-    // position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // texture coord attribute
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+int GameManager::GetTargetsInView(const Camera& camera, float halfAngleDeg, std::vector<unsigned int>* outSlots) const {
+    CGTP_PROFILE_SCOPE("Visibility Query");
+    std::vector<unsigned int>& result = outSlots ? *outSlots : queryScratch;
+    targetGrid.ConeQuery(camera.Position, camera.Front, halfAngleDeg, MAX_SHOT_DISTANCE, result);
+    return static_cast<int>(result.size());
 }
 
 // Simple Ray-Sphere Intersection
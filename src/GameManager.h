@@ -1,36 +1,64 @@
 #ifndef GAMEMANAGER_H
 #define GAMEMANAGER_H
 
-#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <random>
 #include <vector>
 #include "Camera.h"
-#include "Shader.h"
+#include "DroneSwarm.h"
+#include "TargetGrid.h"
+#include "TargetPool.h"
 
-struct Target {
-    glm::vec3 position;
-    float activeTime;
-    bool isActive;
+// Gameplay tuning (cgtp_batchsim sweeps these for balancing)
+struct GameConfig {
+    float GameDuration = 90.0f;         // [Modified] 1.5 minutes (90s)
+    float SpawnInterval = 3.0f;         // Spawn every 3 seconds
+    int MaxTargets = 10;
+    float FarDistanceThreshold = 15.0f; // Distance to require zoom
+    float RequiredZoom = 20.0f;         // FOV must be less than this
 };
 
+// Game rules and target simulation. Pure CPU: no GL calls, so sessions can run without a
+// context (TargetRenderer draws the targets).
 class GameManager {
 public:
     GameManager();
-    ~GameManager();
 
-    void Init();
+    // One simulation step (main.cpp runs these on a fixed clock, see FixedTimestep)
     void Update(float deltaTime);
-    void Render(Shader& shader);
+    // The next `steps` Updates are one frame: the drone kernel's budget is per frame
+    void BeginFrame(int steps) { drones.BeginFrame(steps); }
     bool CheckShot(Camera& camera, bool& outHit); // Returns true if click was processed
+    // Narrow phase of CheckShot
+    static bool RaySphereIntersect(glm::vec3 rayOrigin, glm::vec3 rayDir, glm::vec3 sphereCenter, float sphereRadius);
+    // Visual lock: targets within halfAngleDeg of the camera's view direction (outSlots receives handle slots)
+    int GetTargetsInView(const Camera& camera, float halfAngleDeg, std::vector<unsigned int>* outSlots = nullptr) const;
 
     // Game Control
     void StartGame();
     void ResetGame();
 
+    // Spawns draw from an RNG reseeded with this on every StartGame, so a game replays exactly
+    void SetSeed(uint32_t value) { seed = value; }
+    uint32_t GetSeed() const { return seed; }
+
+    // Applied immediately; GameDuration takes effect on the next StartGame
+    void SetConfig(const GameConfig& value) { config = value; }
+    const GameConfig& GetConfig() const { return config; }
+
+    // Drone mode: targets fly as a flock instead of sitting on buildings (applied on next StartGame)
+    void SetDroneMode(bool enabled, int count);
+    bool IsDroneMode() const { return droneMode; }
+    int GetDroneCount() const { return droneCount; }
+    DroneSwarm& GetDroneSwarm() { return drones; }
+    void SetObstacles(const std::vector<AABB>& buildingBounds) { drones.SetObstacles(buildingBounds); }
+
     // Getters
     float GetTimeLeft() const { return timeLeft; }
     int GetScore() const { return score; }
     bool IsGameOver() const { return isGameOver; }
+    const TargetPool& GetTargets() const { return targets; }
     
 private:
     // Game State
@@ -38,23 +66,27 @@ private:
     int score;
     bool isGameOver;
     float spawnTimer;
+    bool droneMode;
+    int droneCount;
+    uint32_t seed;
+    std::mt19937 rng;
     
     // Config
-    const float GAME_DURATION = 90.0f; // [Modified] 1.5 minutes (90s)
-    const float SPAWN_INTERVAL = 3.0f; // Spawn every 3 seconds
-    const float MAX_TARGETS = 10;
+    GameConfig config;
     const float HIT_DISTANCE_THRESHOLD = 1.0f; // Precision required
-    const float FAR_DISTANCE_THRESHOLD = 15.0f; // Distance to require zoom
-    const float REQUIRED_ZOOM = 20.0f; // FOV must be less than this
+    const float TARGET_RADIUS = 0.8f; // Hit sphere around the cube center
+    const float MAX_SHOT_DISTANCE = 1000.0f; // Matches the far plane
+    const size_t LINEAR_SCAN_LIMIT = 64; // Below this a column scan beats walking the grid
 
     // Targets
-    std::vector<Target> targets;
-    unsigned int cubeVAO, cubeVBO;
+    TargetPool targets;
+    TargetGrid targetGrid; // Spatial index keyed by handle slot
+    DroneSwarm drones;
+    mutable std::vector<unsigned int> queryScratch;
 
     // Helpers
     void SpawnTarget();
-    void InitRenderData();
-    bool RaySphereIntersect(glm::vec3 rayOrigin, glm::vec3 rayDir, glm::vec3 sphereCenter, float sphereRadius);
+    void RemoveTarget(TargetHandle handle);
 };
 
 #endif
@@ -0,0 +1,212 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+bool GpuProfiler::Enabled = true;
+GpuProfiler::FrameSlot GpuProfiler::slots[GpuProfiler::FRAMES_IN_FLIGHT];
+GpuProfiler::FrameSlot* GpuProfiler::current = nullptr;
+std::vector<int> GpuProfiler::openMarkers;
+unsigned long long GpuProfiler::frameIndex = 0;
+std::deque<GpuProfiler::FrameRecord> GpuProfiler::history;
+std::vector<std::string> GpuProfiler::names;
+int GpuProfiler::droppedFrames = 0;
+
+static std::unordered_map<std::string, int> nameIds;
+
+double GpuProfiler::NowUs() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+int GpuProfiler::Intern(const std::string& name) {
+    auto it = nameIds.find(name);
+    if (it != nameIds.end()) return it->second;
+    int id = static_cast<int>(names.size());
+    names.push_back(name);
+    nameIds[name] = id;
+    return id;
+}
+
+int GpuProfiler::IssueTimestamp(FrameSlot& slot) {
+    if (slot.QueriesUsed == slot.Queries.size()) {
+        unsigned int query;
+        glGenQueries(1, &query);
+        slot.Queries.push_back(query);
+    }
+    int index = static_cast<int>(slot.QueriesUsed++);
+    glQueryCounter(slot.Queries[index], GL_TIMESTAMP);
+    return index;
+}
+
+bool GpuProfiler::Collect(FrameSlot& slot) {
+    // Timestamps complete in order, so the last one tells for the whole frame
+    if (slot.QueriesUsed > 0) {
+        GLint available = 0;
+        glGetQueryObjectiv(slot.Queries[slot.QueriesUsed - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) return false;
+    }
+
+    FrameRecord record;
+    record.Frame = slot.Frame;
+    record.CpuBeginUs = slot.CpuBeginUs;
+    record.CpuEndUs = slot.CpuEndUs;
+    record.Samples.reserve(slot.Markers.size());
+    for (const Marker& m : slot.Markers) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(slot.Queries[m.QueryBegin], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(slot.Queries[m.QueryEnd], GL_QUERY_RESULT, &end);
+        Sample s;
+        s.NameId = m.NameId;
+        s.Depth = m.Depth;
+        s.CpuBeginUs = m.CpuBeginUs;
+        s.CpuEndUs = m.CpuEndUs;
+        s.GpuBeginUs = slot.CpuReferenceUs + (static_cast<GLint64>(begin) - slot.GpuReferenceNs) / 1000.0;
+        s.GpuEndUs = slot.CpuReferenceUs + (static_cast<GLint64>(end) - slot.GpuReferenceNs) / 1000.0;
+        record.Samples.push_back(s);
+    }
+    history.push_back(record);
+    while (history.size() > static_cast<size_t>(HISTORY_FRAMES))
+        history.pop_front();
+    slot.Pending = false;
+    return true;
+}
+
+void GpuProfiler::BeginFrame() {
+    if (current) EndFrame();
+    frameIndex++;
+
+    // Read back whatever the GPU has finished, oldest first
+    for (int k = 0; k < FRAMES_IN_FLIGHT; k++) {
+        FrameSlot& slot = slots[(frameIndex + k) % FRAMES_IN_FLIGHT];
+        if (slot.Pending && !Collect(slot)) break;
+    }
+
+    openMarkers.clear();
+    if (!Enabled) return;
+
+    FrameSlot& slot = slots[frameIndex % FRAMES_IN_FLIGHT];
+    if (slot.Pending) {
+        // GPU more than FRAMES_IN_FLIGHT behind: give up on that frame rather than wait
+        slot.Pending = false;
+        droppedFrames++;
+    }
+    slot.Frame = frameIndex;
+    slot.Markers.clear();
+    slot.QueriesUsed = 0;
+    slot.CpuBeginUs = NowUs();
+    glGetInteger64v(GL_TIMESTAMP, &slot.GpuReferenceNs);
+    slot.CpuReferenceUs = NowUs();
+    current = &slot;
+}
+
+void GpuProfiler::EndFrame() {
+    if (!current) return;
+    while (!openMarkers.empty())
+        End();
+    current->CpuEndUs = NowUs();
+    current->Pending = true;
+    current = nullptr;
+}
+
+void GpuProfiler::Begin(const std::string& name) {
+    if (!current) {
+        openMarkers.push_back(-1);
+        return;
+    }
+    Marker m;
+    m.NameId = Intern(name);
+    m.Depth = static_cast<int>(openMarkers.size());
+    m.CpuBeginUs = NowUs();
+    m.QueryBegin = IssueTimestamp(*current);
+    m.QueryEnd = m.QueryBegin;
+    m.CpuEndUs = m.CpuBeginUs;
+    openMarkers.push_back(static_cast<int>(current->Markers.size()));
+    current->Markers.push_back(m);
+}
+
+void GpuProfiler::End() {
+    if (openMarkers.empty()) return;
+    int index = openMarkers.back();
+    openMarkers.pop_back();
+    if (index < 0 || !current) return;
+    Marker& m = current->Markers[index];
+    m.QueryEnd = IssueTimestamp(*current);
+    m.CpuEndUs = NowUs();
+}
+
+void GpuProfiler::GetAverages(int frames, std::vector<ScopeStats>& out) {
+    out.clear();
+    if (history.empty()) return;
+
+    // Rows follow the latest frame; a scope is matched by name and depth in the older ones
+    const FrameRecord& latest = history.back();
+    std::vector<double> cpu(latest.Samples.size(), 0.0), gpu(latest.Samples.size(), 0.0);
+    std::vector<int> count(latest.Samples.size(), 0);
+    int first = std::max(0, static_cast<int>(history.size()) - frames);
+    for (size_t f = first; f < history.size(); f++) {
+        const FrameRecord& record = history[f];
+        for (const Sample& s : record.Samples) {
+            for (size_t r = 0; r < latest.Samples.size(); r++) {
+                if (latest.Samples[r].NameId == s.NameId && latest.Samples[r].Depth == s.Depth) {
+                    cpu[r] += s.CpuEndUs - s.CpuBeginUs;
+                    gpu[r] += s.GpuEndUs - s.GpuBeginUs;
+                    count[r]++;
+                    break;
+                }
+            }
+        }
+    }
+    for (size_t r = 0; r < latest.Samples.size(); r++) {
+        ScopeStats stats;
+        stats.NameId = latest.Samples[r].NameId;
+        stats.Depth = latest.Samples[r].Depth;
+        stats.CpuMs = count[r] ? static_cast<float>(cpu[r] / count[r] / 1000.0) : 0.0f;
+        stats.GpuMs = count[r] ? static_cast<float>(gpu[r] / count[r] / 1000.0) : 0.0f;
+        out.push_back(stats);
+    }
+}
+
+float GpuProfiler::GetFrameGpuMs(const FrameRecord& record) {
+    double us = 0.0;
+    for (const Sample& sample : record.Samples)
+        if (sample.Depth == 0) us += sample.GpuEndUs - sample.GpuBeginUs;
+    return static_cast<float>(us / 1000.0);
+}
+
+static void WriteEvent(std::ofstream& out, bool& first, const std::string& name, const char* category,
+                       int tid, double beginUs, double endUs) {
+    char line[512];
+    std::snprintf(line, sizeof(line),
+        "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+        first ? "" : ",", name.c_str(), category, tid, beginUs, endUs > beginUs ? endUs - beginUs : 0.0);
+    out << line;
+    first = false;
+}
+
+bool GpuProfiler::ExportChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::GPU_PROFILER:: Cannot write " << path << std::endl;
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},";
+    out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    bool first = false;
+    for (const FrameRecord& record : history) {
+        WriteEvent(out, first, "Frame " + std::to_string(record.Frame), "frame", 1, record.CpuBeginUs, record.CpuEndUs);
+        for (const Sample& s : record.Samples) {
+            WriteEvent(out, first, names[s.NameId], "cpu", 1, s.CpuBeginUs, s.CpuEndUs);
+            WriteEvent(out, first, names[s.NameId], "gpu", 2, s.GpuBeginUs, s.GpuEndUs);
+        }
+    }
+    out << "\n]}\n";
+    std::cout << "GPU profiler: wrote " << history.size() << " frames to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,47 @@
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer() : current(0), smoothedMs(0.0f), hasResult(false) {
+    glGenQueries(QUERY_COUNT, queries);
+    for (int i = 0; i < QUERY_COUNT; i++)
+        pending[i] = false;
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(QUERY_COUNT, queries);
+}
+
+void GpuTimer::Begin() {
+    Collect();
+    // All slots still in flight (GPU far behind): drop this sample rather than wait
+    if (pending[current]) return;
+    glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+}
+
+void GpuTimer::End() {
+    if (pending[current]) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    pending[current] = true;
+    current = (current + 1) % QUERY_COUNT;
+}
+
+void GpuTimer::Collect() {
+    // Oldest first, so results are consumed in submission order
+    for (int k = 0; k < QUERY_COUNT; k++) {
+        int i = (current + k) % QUERY_COUNT;
+        if (!pending[i]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &ns);
+        pending[i] = false;
+
+        float ms = static_cast<float>(ns) / 1.0e6f;
+        // Some drivers report garbage for a query issued right after context creation
+        if (ms > 1000.0f) continue;
+        smoothedMs = hasResult ? smoothedMs * 0.9f + ms * 0.1f : ms;
+        hasResult = true;
+    }
+}
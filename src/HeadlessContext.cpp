@@ -0,0 +1,140 @@
+#include "HeadlessContext.h"
+
+#if defined(CGTP_HAS_EGL)
+
+#include <EGL/egl.h>
+#include <cstring>
+
+// From EGL/eglext.h (not every SDK ships it)
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+#ifndef EGL_PLATFORM_DEVICE_EXT
+#define EGL_PLATFORM_DEVICE_EXT 0x313F
+#endif
+typedef EGLDisplay (*GetPlatformDisplayFn)(EGLenum platform, void* nativeDisplay, const EGLint* attribs);
+typedef EGLBoolean (*QueryDevicesFn)(EGLint maxDevices, void** devices, EGLint* numDevices);
+
+static bool HasExtension(const char* list, const char* name) {
+    if (!list) return false;
+    size_t length = std::strlen(name);
+    for (const char* p = std::strstr(list, name); p; p = std::strstr(p + length, name))
+        if ((p == list || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+            return true;
+    return false;
+}
+
+HeadlessContext::HeadlessContext() : display(nullptr), context(nullptr), platformName("none") {
+}
+
+HeadlessContext::~HeadlessContext() {
+    Destroy();
+}
+
+bool HeadlessContext::Create(std::string& error) {
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    GetPlatformDisplayFn getPlatformDisplay = reinterpret_cast<GetPlatformDisplayFn>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    // Pick a display that needs no window system, most specific first
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    if (getPlatformDisplay && HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        platformName = "surfaceless";
+    }
+    if ((dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, nullptr, nullptr))
+        && getPlatformDisplay && HasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+        QueryDevicesFn queryDevices = reinterpret_cast<QueryDevicesFn>(eglGetProcAddress("eglQueryDevicesEXT"));
+        void* devices[4];
+        EGLint count = 0;
+        if (queryDevices && queryDevices(4, devices, &count) && count > 0) {
+            dpy = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[0], nullptr);
+            platformName = "device";
+        }
+    }
+    if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, nullptr, nullptr)) {
+        dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        platformName = "default";
+        if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, nullptr, nullptr)) {
+            error = "no EGL display";
+            return false;
+        }
+    }
+    display = dpy;
+
+    if (!HasExtension(eglQueryString(dpy, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+        error = "EGL_KHR_surfaceless_context not supported";
+        Destroy();
+        return false;
+    }
+
+    // EGL_SURFACE_TYPE defaults to EGL_WINDOW_BIT, which surfaceless displays never have
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, 0,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(dpy, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        error = "no EGL config with desktop OpenGL";
+        Destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(dpy, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        context = nullptr;
+        error = "cannot create an OpenGL 3.3 core context";
+        Destroy();
+        return false;
+    }
+    if (!eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, static_cast<EGLContext>(context))) {
+        error = "eglMakeCurrent failed";
+        Destroy();
+        return false;
+    }
+    return true;
+}
+
+void HeadlessContext::Destroy() {
+    if (!display) return;
+    eglMakeCurrent(static_cast<EGLDisplay>(display), EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context) eglDestroyContext(static_cast<EGLDisplay>(display), static_cast<EGLContext>(context));
+    eglTerminate(static_cast<EGLDisplay>(display));
+    context = nullptr;
+    display = nullptr;
+}
+
+void* HeadlessContext::GetProcAddress(const char* name) {
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+#else
+
+HeadlessContext::HeadlessContext() : display(nullptr), context(nullptr), platformName("none") {
+}
+
+HeadlessContext::~HeadlessContext() {
+}
+
+bool HeadlessContext::Create(std::string& error) {
+    error = "built without EGL";
+    return false;
+}
+
+void HeadlessContext::Destroy() {
+}
+
+void* HeadlessContext::GetProcAddress(const char*) {
+    return nullptr;
+}
+
+#endif
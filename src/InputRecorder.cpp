@@ -0,0 +1,175 @@
+#include "InputRecorder.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+static const char MAGIC[4] = { 'C', 'G', 'T', 'I' };
+
+static double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void Put(std::ofstream& out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+static void PutFloat(std::ofstream& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Put(out, bits, 4);
+}
+
+// Reads from the replay buffer; false when the record is cut short
+static bool Get(const std::vector<unsigned char>& data, size_t& offset, int bytes, uint32_t& value) {
+    if (offset + bytes > data.size()) return false;
+    value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+    offset += bytes;
+    return true;
+}
+
+static bool GetFloat(const std::vector<unsigned char>& data, size_t& offset, float& value) {
+    uint32_t bits;
+    if (!Get(data, offset, 4, bits)) return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+InputRecorder::InputRecorder()
+    : mode(OFF), seed(0), frame(0), frameCount(0), replayOffset(0), lastRecordTime(0.0), eventCount(0) {
+}
+
+InputRecorder::~InputRecorder() {
+    Stop();
+}
+
+bool InputRecorder::StartRecording(const std::string& path, uint32_t sessionSeed, std::string& error) {
+    Stop();
+    out.open(path, std::ios::binary);
+    if (!out) {
+        error = "cannot write " + path;
+        return false;
+    }
+    out.write(MAGIC, sizeof(MAGIC));
+    Put(out, FORMAT_VERSION, 2);
+    Put(out, sessionSeed, 4);
+
+    mode = RECORDING;
+    seed = sessionSeed;
+    frame = 0;
+    eventCount = 0;
+    lastRecordTime = Now();
+    return true;
+}
+
+bool InputRecorder::StartReplay(const std::string& path, std::string& error) {
+    Stop();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    replayData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    uint32_t version = 0;
+    replayOffset = sizeof(MAGIC);
+    if (replayData.size() < sizeof(MAGIC) || std::memcmp(replayData.data(), MAGIC, sizeof(MAGIC)) != 0
+        || !Get(replayData, replayOffset, 2, version) || !Get(replayData, replayOffset, 4, seed)) {
+        error = path + " is not an input recording";
+        return false;
+    }
+    if (version != FORMAT_VERSION) {
+        error = path + ": unsupported format version " + std::to_string(version);
+        return false;
+    }
+
+    // Count the frames up front (progress / end of replay)
+    frameCount = 0;
+    for (size_t i = replayOffset; i < replayData.size();) {
+        uint8_t type = replayData[i];
+        i += 1 + 4 + (type == FRAME_RECORD ? 4 : (type <= InputEvent::MOUSE_BUTTON ? 3 : 8));
+        if (type == FRAME_RECORD && i <= replayData.size()) frameCount++;
+    }
+
+    mode = REPLAYING;
+    frame = 0;
+    return true;
+}
+
+void InputRecorder::Stop() {
+    if (mode == RECORDING) {
+        out.close();
+        std::cout << "Input: recorded " << eventCount << " events over " << frame << " frames (seed " << seed << ")" << std::endl;
+    }
+    replayData.clear();
+    replayData.shrink_to_fit();
+    mode = OFF;
+}
+
+void InputRecorder::WriteHeader(uint8_t type) {
+    double now = Now();
+    double elapsedUs = (now - lastRecordTime) * 1e6;
+    lastRecordTime = now;
+    out.put(static_cast<char>(type));
+    Put(out, elapsedUs < 4294967295.0 ? static_cast<uint32_t>(elapsedUs) : 0xFFFFFFFFu, 4);
+}
+
+void InputRecorder::Record(const InputEvent& e) {
+    if (mode != RECORDING) return;
+    WriteHeader(e.EventType);
+    if (e.EventType == InputEvent::KEY || e.EventType == InputEvent::MOUSE_BUTTON) {
+        Put(out, static_cast<uint32_t>(static_cast<int16_t>(e.Code)), 2);
+        Put(out, static_cast<uint32_t>(e.Action), 1);
+    } else {
+        PutFloat(out, e.X);
+        PutFloat(out, e.Y);
+    }
+    eventCount++;
+}
+
+void InputRecorder::EndFrame(float deltaTime) {
+    if (mode != RECORDING) return;
+    WriteHeader(FRAME_RECORD);
+    PutFloat(out, deltaTime);
+    frame++;
+}
+
+bool InputRecorder::NextFrame(std::vector<InputEvent>& outEvents, float& outDeltaTime) {
+    outEvents.clear();
+    if (mode != REPLAYING) return false;
+
+    size_t offset = replayOffset;
+    uint32_t type, timestamp, value;
+    while (Get(replayData, offset, 1, type) && Get(replayData, offset, 4, timestamp)) {
+        if (type == FRAME_RECORD) {
+            if (!GetFloat(replayData, offset, outDeltaTime)) break;
+            replayOffset = offset;
+            frame++;
+            return true;
+        }
+
+        InputEvent e;
+        e.EventType = static_cast<InputEvent::Type>(type);
+        if (type == InputEvent::KEY || type == InputEvent::MOUSE_BUTTON) {
+            if (!Get(replayData, offset, 2, value)) break;
+            e.Code = static_cast<int16_t>(value);
+            if (!Get(replayData, offset, 1, value)) break;
+            e.Action = static_cast<int>(value);
+        } else if (type == InputEvent::CURSOR || type == InputEvent::SCROLL) {
+            if (!GetFloat(replayData, offset, e.X) || !GetFloat(replayData, offset, e.Y)) break;
+        } else {
+            std::cout << "ERROR::INPUT:: Unknown record type " << type << " in frame " << frame << std::endl;
+            break;
+        }
+        outEvents.push_back(e);
+    }
+
+    // End of the log (or a truncated last frame, e.g. the recording process was killed)
+    outEvents.clear();
+    replayOffset = replayData.size();
+    return false;
+}
@@ -0,0 +1,227 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+struct Job {
+    std::function<void()> Fn;
+    JobSystem::Counter* Done;
+    const JobSystem::Counter* After;
+};
+
+struct Queue {
+    std::mutex Lock;
+    std::deque<Job> Jobs; // Owner takes from the back, thieves from the front
+    std::atomic<long long> BusyNs{0}, JobCount{0}, Steals{0};
+};
+
+std::vector<std::unique_ptr<Queue>> queues; // [0] = non-worker threads
+std::vector<std::thread> workers;
+std::atomic<bool> running(false);
+std::atomic<bool> quit(false);
+std::atomic<int> queued(0); // Jobs sitting in any deque
+std::atomic<unsigned> epoch(0); // Bumped under sleepLock when a job is queued or a counter reaches zero
+std::mutex sleepLock;
+std::condition_variable wake;
+std::chrono::steady_clock::time_point lastSample;
+
+thread_local int threadIndex = 0;
+thread_local int jobDepth = 0; // Nested jobs (helping inside Wait) are timed by the outer one
+
+// A group finished: wake everyone, its waiters and the workers holding jobs that depend on it
+void SignalDone() {
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        epoch++;
+    }
+    wake.notify_all();
+}
+
+void Execute(Job& job, Queue& queue) {
+    auto start = std::chrono::steady_clock::now();
+    jobDepth++;
+    job.Fn();
+    jobDepth--;
+    if (jobDepth == 0)
+        queue.BusyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    queue.JobCount++;
+    if (job.Done && job.Done->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        SignalDone(); // Never touches the counter: its owner may free it right away
+}
+
+bool IsReady(const Job& job) {
+    return !job.After || job.After->IsDone();
+}
+
+// Pop own deque, else steal; jobs whose dependency is not done are skipped.
+// False when nothing runnable was found.
+bool TryRunOne() {
+    if (queued.load(std::memory_order_acquire) == 0) return false;
+    const int self = threadIndex;
+    const int count = static_cast<int>(queues.size());
+    Job job;
+    bool found = false, stolen = false;
+    for (int k = 0; k < count && !found; k++) {
+        Queue& q = *queues[(self + k) % count];
+        std::lock_guard<std::mutex> lock(q.Lock);
+        if (k == 0) {
+            for (auto it = q.Jobs.rbegin(); it != q.Jobs.rend(); ++it) {
+                if (!IsReady(*it)) continue;
+                job = std::move(*it);
+                q.Jobs.erase(std::next(it).base());
+                found = true;
+                break;
+            }
+        } else {
+            for (auto it = q.Jobs.begin(); it != q.Jobs.end(); ++it) {
+                if (!IsReady(*it)) continue;
+                job = std::move(*it);
+                q.Jobs.erase(it);
+                found = stolen = true;
+                break;
+            }
+        }
+    }
+    if (!found) return false;
+
+    queued--;
+    Queue& own = *queues[self];
+    if (stolen) own.Steals++;
+    Execute(job, own);
+    return true;
+}
+
+void WorkerLoop(int index) {
+    threadIndex = index;
+    CGTP_PROFILE_THREAD("Job Worker");
+    while (!quit.load(std::memory_order_acquire)) {
+        const unsigned seen = epoch.load(std::memory_order_acquire);
+        if (TryRunOne()) continue;
+        // Nothing runnable (empty, or only jobs waiting on a dependency): sleep until a job is
+        // queued or a counter is done
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [seen]() { return quit.load() || epoch.load() != seen; });
+    }
+}
+
+// Keeps the workers from outliving main when Shutdown is never called
+struct AutoShutdown {
+    ~AutoShutdown() { JobSystem::Shutdown(); }
+} autoShutdown;
+
+}
+
+void JobSystem::Init(int workerCount) {
+    if (running) return;
+    if (workerCount < 0)
+        workerCount = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    quit = false;
+    queues.clear();
+    for (int i = 0; i <= workerCount; i++)
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    running = true;
+    for (int i = 1; i <= workerCount; i++)
+        workers.emplace_back(WorkerLoop, i);
+    lastSample = std::chrono::steady_clock::now();
+}
+
+void JobSystem::Shutdown() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepLock);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& w : workers) w.join();
+    workers.clear();
+    running = false;
+    // Jobs never run: release their counters so no one waits forever
+    for (auto& q : queues)
+        for (Job& job : q->Jobs)
+            if (job.Done) job.Done->Pending--;
+    queues.clear();
+    queued = 0;
+    SignalDone();
+}
+
+bool JobSystem::IsRunning() {
+    return running;
+}
+
+int JobSystem::GetThreadCount() {
+    return running ? static_cast<int>(queues.size()) : 1;
+}
+
+void JobSystem::Run(std::function<void()> job, Counter* counter, const Counter* dependency) {
+    if (!running) {
+        // Inline mode: a dependency was run inline too, so it is already done
+        job();
+        return;
+    }
+    if (counter) counter->Pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        Queue& q = *queues[threadIndex];
+        std::lock_guard<std::mutex> lock(q.Lock);
+        q.Jobs.push_back({ std::move(job), counter, dependency });
+    }
+    queued++;
+    {
+        std::lock_guard<std::mutex> lock(sleepLock); // No wakeup lost between a worker's check and its wait
+        epoch++;
+    }
+    wake.notify_one();
+}
+
+void JobSystem::Wait(const Counter& counter) {
+    while (!counter.IsDone()) {
+        const unsigned seen = epoch.load(std::memory_order_acquire);
+        if (TryRunOne()) continue;
+        // The group's last jobs run elsewhere (or wait on a dependency): sleep until one finishes
+        std::unique_lock<std::mutex> lock(sleepLock);
+        wake.wait(lock, [&counter, seen]() { return counter.IsDone() || epoch.load() != seen; });
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    minChunk = std::max<size_t>(1, minChunk);
+    if (!running || count <= minChunk) {
+        fn(0, count);
+        return;
+    }
+    // A few chunks per thread, so stealing can even out uneven chunks
+    size_t chunks = std::min((count + minChunk - 1) / minChunk, static_cast<size_t>(GetThreadCount()) * 4);
+    size_t perChunk = (count + chunks - 1) / chunks;
+    Counter done;
+    for (size_t begin = perChunk; begin < count; begin += perChunk) {
+        size_t end = std::min(count, begin + perChunk);
+        Run([&fn, begin, end]() { fn(begin, end); }, &done);
+    }
+    fn(0, std::min(count, perChunk));
+    Wait(done);
+}
+
+void JobSystem::SampleStats(std::vector<WorkerStats>& out) {
+    out.clear();
+    if (!running) return;
+    auto now = std::chrono::steady_clock::now();
+    double elapsedNs = std::max(1.0, static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSample).count()));
+    lastSample = now;
+    for (size_t i = 0; i < queues.size(); i++) {
+        Queue& q = *queues[i];
+        WorkerStats s;
+        s.Name = i == 0 ? "main" : "worker " + std::to_string(i);
+        s.Utilization = static_cast<float>(std::min(1.0, q.BusyNs.exchange(0) / elapsedNs));
+        s.Jobs = q.JobCount.exchange(0);
+        s.Steals = q.Steals.exchange(0);
+        out.push_back(s);
+    }
+}
@@ -0,0 +1,49 @@
+#include "LatencyLog.h"
+
+static float Ms(LatencyLog::Clock::time_point from, LatencyLog::Clock::time_point to) {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+
+LatencyLog::LatencyLog() : clicks(0), sumMs(0.0), lastMs(0.0f) {
+}
+
+bool LatencyLog::Open(const std::string& path, std::string& error) {
+    Close();
+    file.open(path);
+    if (!file) {
+        error = "cannot write " + path;
+        return false;
+    }
+    file << "click,input_s,shot_ms,submit_ms,gpu_done_ms,frame,hit\n";
+    start = Clock::now();
+    clicks = 0;
+    sumMs = 0.0;
+    lastMs = 0.0f;
+    return true;
+}
+
+void LatencyLog::Close() {
+    pending.clear();
+    if (file.is_open())
+        file.close();
+}
+
+void LatencyLog::AddClick(const ClickTiming& click, unsigned long long frame, Clock::time_point submitted) {
+    if (!file.is_open() || !click.Valid) return;
+    pending.push_back({ click, frame, submitted });
+}
+
+void LatencyLog::Complete(unsigned long long frame, Clock::time_point time) {
+    while (!pending.empty() && pending.front().Frame <= frame) {
+        const Pending& p = pending.front();
+        const Clock::time_point input = p.Click.Input;
+        lastMs = Ms(input, time);
+        sumMs += lastMs;
+        clicks++;
+        // Milliseconds after the input
+        file << clicks << ',' << std::chrono::duration<double>(input - start).count() << ','
+             << Ms(input, p.Click.Shot) << ',' << Ms(input, p.Submitted) << ',' << lastMs << ','
+             << p.Frame << ',' << (p.Click.Hit ? 1 : 0) << '\n';
+        pending.pop_front();
+    }
+}
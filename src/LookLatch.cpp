@@ -0,0 +1,20 @@
+#include "LookLatch.h"
+
+void LookLatch::Track(const InputEvent& e) {
+    if (e.EventType != InputEvent::CURSOR) return;
+    const glm::vec2 position(e.X, e.Y);
+    // Same as the mouse look: the first position only sets the reference; y is flipped
+    if (hasLast)
+        total += glm::vec2(position.x - last.x, last.y - position.y);
+    last = position;
+    hasLast = true;
+}
+
+Camera LookLatch::Apply(const Camera& eye, const glm::vec2& since) const {
+    Camera latched = eye;
+    const float maxOffset = MAX_DEGREES / eye.MouseSensitivity;
+    const glm::vec2 offset = glm::clamp(total - since, -maxOffset, maxOffset);
+    if (offset != glm::vec2(0.0f))
+        latched.ProcessMouseMovement(offset.x, offset.y);
+    return latched;
+}
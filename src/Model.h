@@ -12,6 +12,12 @@
 #include <assimp/postprocess.h>
 
 #include "Shader.h"
+#include "Profiler.h"
+#include "AABB.h"
+#include "Frustum.h"
+#include "RenderStats.h"
+#include "RenderCommands.h"
+#include "JobSystem.h"
 
 #include <string>
 #include <fstream>
@@ -40,22 +46,33 @@ public:
     vector<Vertex>       vertices;
     vector<unsigned int> indices;
     vector<Texture>      textures;
-    unsigned int VAO;
+    unsigned int VAO = 0;
+    AABB Bounds; // [New] Model-space bounds of the vertices (frustum culling, drone obstacles)
 
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures) {
+    // [Modified] upload = false keeps the mesh CPU-only (no GL context needed) until Upload()
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, bool upload = true) {
         this->vertices = vertices;
         this->indices = indices;
         this->textures = textures;
-        setupMesh();
+        for (const Vertex& v : this->vertices) Bounds.Expand(v.Position);
+        if (upload)
+            setupMesh();
+    }
+
+    // [New] Create the VAO / buffers of a mesh built with upload = false
+    void Upload() {
+        if (VAO == 0)
+            setupMesh();
     }
 
     // 
-    void Draw(Shader& shader) {
+    // [Modified] Recorded into cmd (executed at once by the default immediate buffer)
+    void Draw(Shader& shader, RenderCommandBuffer& cmd = RenderCommandBuffer::Immediate()) {
         unsigned int diffuseNr = 1;
         unsigned int specularNr = 1;
 
         for (unsigned int i = 0; i < textures.size(); i++) {
-            glActiveTexture(GL_TEXTURE0 + i);
+            cmd.ActiveTexture(i);
             string number;
             string name = textures[i].type;
             if (name == "texture_diffuse")
@@ -64,18 +81,19 @@ public:
                 number = std::to_string(specularNr++);
 
             //  uniform: material.texture_diffuse1
-            shader.setInt(("material." + name + number).c_str(), i);
-            glBindTexture(GL_TEXTURE_2D, textures[i].id);
+            cmd.SetInt(shader, "material." + name + number, i);
+            cmd.BindTexture(textures[i].id);
         }
 
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
-        glActiveTexture(GL_TEXTURE0);
+        cmd.BindVertexArray(VAO);
+        cmd.DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT);
+        RenderStats::AddDraw(static_cast<long long>(indices.size() / 3));
+        cmd.BindVertexArray(0);
+        cmd.ActiveTexture(0);
     }
 
 private:
-    unsigned int VBO, EBO;
+    unsigned int VBO = 0, EBO = 0;
     void setupMesh() {
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
@@ -109,27 +127,90 @@ public:
     vector<Mesh>    meshes;
     string directory;
     bool gammaCorrection;
+    bool uploadToGpu; // [New] false: import + convert + decode only (benchmarks, loading off the GL thread)
+
+    // ؼ Flag: Triangulate(ת), FlipUVs(תY), CalcTangentSpace(ͼ)
+    static const unsigned int IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
 
-    Model(string const& path, bool gamma = false) : gammaCorrection(gamma) {
+    Model(string const& path, bool gamma = false, bool upload = true) : gammaCorrection(gamma), uploadToGpu(upload) {
         loadModel(path);
     }
 
-    void Draw(Shader& shader) {
+    // [New] Conversion only, from a scene the caller imported (textures resolve against directory)
+    Model(const aiScene* scene, string const& directory, bool upload = true) : directory(directory), gammaCorrection(false), uploadToGpu(upload) {
+        CGTP_PROFILE_SCOPE("Mesh Conversion");
+        processNode(scene->mRootNode, scene);
+    }
+
+    // [New] GL objects for a model loaded with upload = false (textures stay unloaded)
+    void Upload() {
+        for (Mesh& mesh : meshes)
+            mesh.Upload();
+        uploadToGpu = true;
+    }
+
+    void Draw(Shader& shader, RenderCommandBuffer& cmd = RenderCommandBuffer::Immediate()) {
+        for (unsigned int i = 0; i < meshes.size(); i++)
+            meshes[i].Draw(shader, cmd);
+    }
+
+    // [New] Skip meshes whose world bounds lie outside the frustum. The world bounds are
+    // cached per model matrix, so a static model pays for 8 corner transforms once.
+    void Draw(Shader& shader, const Frustum& frustum, const glm::mat4& model, RenderCommandBuffer& cmd = RenderCommandBuffer::Immediate()) {
+        Cull(frustum, model, visibleScratch);
+        Draw(shader, visibleScratch, cmd);
+    }
+
+    // [New] Indices of the meshes inside the frustum. No GL calls, so it can run on the game
+    // thread while the GL thread draws the list of the previous frame (one caller at a time)
+    void Cull(const Frustum& frustum, const glm::mat4& model, vector<unsigned int>& visibleMeshes) {
+        if (worldBounds.size() != meshes.size() || model != boundsModel) {
+            worldBounds.clear();
+            for (const Mesh& mesh : meshes)
+                worldBounds.push_back(mesh.Bounds.IsValid() ? mesh.Bounds.Transformed(model) : mesh.Bounds);
+            boundsModel = model;
+        }
+        // [New] Tests run as jobs for big models
+        visible.resize(meshes.size());
+        JobSystem::ParallelFor(meshes.size(), CULL_BATCH, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                visible[i] = worldBounds[i].IsValid() && frustum.Intersects(worldBounds[i]);
+        });
+        visibleMeshes.clear();
         for (unsigned int i = 0; i < meshes.size(); i++)
-            meshes[i].Draw(shader);
+            if (visible[i]) visibleMeshes.push_back(i);
+    }
+
+    // [New] Draw a list from Cull; every other mesh counts as culled
+    void Draw(Shader& shader, const vector<unsigned int>& visibleMeshes, RenderCommandBuffer& cmd = RenderCommandBuffer::Immediate()) {
+        for (unsigned int i : visibleMeshes)
+            meshes[i].Draw(shader, cmd);
+        for (size_t i = 0; i < meshes.size(); i++)
+            RenderStats::AddCullTest(i >= visibleMeshes.size());
     }
 
 private:
+    static const size_t CULL_BATCH = 512; // Meshes per culling job
+    vector<AABB> worldBounds;
+    vector<uint8_t> visible;
+    vector<unsigned int> visibleScratch;
+    glm::mat4 boundsModel = glm::mat4(1.0f);
+
     void loadModel(string const& path) {
+        CGTP_PROFILE_FUNCTION();
         Assimp::Importer importer;
-        // ؼ Flag: Triangulate(ת), FlipUVs(תY), CalcTangentSpace(ͼ)
-        const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+        const aiScene* scene;
+        {
+            CGTP_PROFILE_SCOPE("Assimp Import");
+            scene = importer.ReadFile(path, IMPORT_FLAGS);
+        }
 
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
             cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << endl;
             return;
         }
         directory = path.substr(0, path.find_last_of('/'));
+        CGTP_PROFILE_SCOPE("Mesh Conversion");
         processNode(scene->mRootNode, scene);
     }
 
@@ -202,7 +283,7 @@ private:
 
         // зͼ (emissive)...
 
-        return Mesh(vertices, indices, textures);
+        return Mesh(vertices, indices, textures, uploadToGpu);
     }
 
     vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, string typeName) {
@@ -232,15 +313,18 @@ private:
 
     // ȡļĹߺ
     unsigned int TextureFromFile(const char* path, const string& directory) {
+        CGTP_PROFILE_SCOPE("Texture Decode");
         string filename = string(path);
         filename = directory + '/' + filename;
 
-        unsigned int textureID;
-        glGenTextures(1, &textureID);
-
+        unsigned int textureID = 0;
         int width, height, nrComponents;
         unsigned char* data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-        if (data) {
+        if (data && !uploadToGpu) {
+            stbi_image_free(data); // Decode cost only
+        }
+        else if (data) {
+            glGenTextures(1, &textureID);
             GLenum format;
             if (nrComponents == 1) format = GL_RED;
             else if (nrComponents == 3) format = GL_RGB;
@@ -0,0 +1,103 @@
+#include "PngWriter.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static uint32_t Crc32(const unsigned char* data, size_t length, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void PutBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+static void WriteChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> chunk;
+    chunk.reserve(data.size() + 12);
+    PutBigEndian(chunk, static_cast<uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    PutBigEndian(chunk, Crc32(chunk.data() + 4, data.size() + 4));
+    file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+bool PngWriter::Write(const std::string& path, int width, int height, int channels, const unsigned char* pixels, bool flipY) {
+    static const unsigned char colorTypes[5] = { 0, 0, 0, 2, 6 }; // By channel count: gray, -, RGB, RGBA
+    if (width <= 0 || height <= 0 || (channels != 1 && channels != 3 && channels != 4)) return false;
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "ERROR::PNG:: Cannot write " << path << std::endl;
+        return false;
+    }
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<unsigned char> header;
+    PutBigEndian(header, static_cast<uint32_t>(width));
+    PutBigEndian(header, static_cast<uint32_t>(height));
+    header.push_back(8);                      // Bit depth
+    header.push_back(colorTypes[channels]);
+    header.push_back(0);                      // Deflate
+    header.push_back(0);                      // Adaptive filtering (every row uses filter 0)
+    header.push_back(0);                      // No interlace
+    WriteChunk(file, "IHDR", header);
+
+    // Scanlines, each prefixed with its filter byte
+    const size_t rowBytes = static_cast<size_t>(width) * channels;
+    std::vector<unsigned char> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        const unsigned char* row = pixels + rowBytes * (flipY ? height - 1 - y : y);
+        raw.push_back(0);
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib stream of stored deflate blocks (at most 65535 bytes each) + Adler-32
+    std::vector<unsigned char> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t a = 1, b = 0;
+    size_t offset = 0;
+    for (;;) {
+        size_t length = raw.size() - offset < 65535 ? raw.size() - offset : 65535;
+        bool last = offset + length == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<unsigned char>(length));
+        zlib.push_back(static_cast<unsigned char>(length >> 8));
+        zlib.push_back(static_cast<unsigned char>(~length));
+        zlib.push_back(static_cast<unsigned char>(~length >> 8));
+        for (size_t i = offset; i < offset + length; i++) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+        if (last) break;
+    }
+    PutBigEndian(zlib, (b << 16) | a);
+    WriteChunk(file, "IDAT", zlib);
+    WriteChunk(file, "IEND", std::vector<unsigned char>());
+    return static_cast<bool>(file);
+}
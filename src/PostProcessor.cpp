@@ -1,35 +1,57 @@
 #include "PostProcessor.h"
+#include "GpuProfiler.h"
+#include "Profiler.h"
+#include "RenderStats.h"
+#include <algorithm>
 #include <iostream>
 
 PostProcessor::PostProcessor(unsigned int width, unsigned int height)
-    : Width(width), Height(height), UseGlitch(false), ScreenShader(nullptr), GlitchShader(nullptr), BlurShader(nullptr), BloomExtractShader(nullptr), MSAAFBO(nullptr), IntermediateFBO(nullptr)
+    : Width(width), Height(height), UseGlitch(false), BlurShader(nullptr), BloomExtractShader(nullptr), Targets(nullptr), Graph(nullptr), PendingWidth(width), PendingHeight(height), DynRes(nullptr), RenderWidth(width), RenderHeight(height), Bloom(nullptr), OutputTarget(nullptr), ActivePost(nullptr), ActiveFeatures(0),
+      HistoryIndex(0), HistoryValid(false), ViewProjection(1.0f), PrevViewProjection(1.0f), FrameIndex(0)
 {
-    // Initialize Shaders
-    ScreenShader = new Shader("shaders/screen.vs", "shaders/screen.fs");
-    GlitchShader = new Shader("shaders/screen.vs", "shaders/glitch.fs");
+    // Initialize Shaders (post variants are compiled on demand, see GetPostShader)
     BlurShader = new Shader("shaders/screen.vs", "shaders/blur.fs"); // [NEW]
     BloomExtractShader = new Shader("shaders/screen.vs", "shaders/extract_bright.fs"); // [NEW]
+    FXAAShader = new Shader("shaders/screen.vs", "shaders/fxaa.fs");
+    SMAAEdgeShader = new Shader("shaders/screen.vs", "shaders/smaa_edges.fs");
+    SMAAWeightShader = new Shader("shaders/screen.vs", "shaders/smaa_weights.fs");
+    SMAABlendShader = new Shader("shaders/screen.vs", "shaders/smaa_blend.fs");
+    TAAShader = new Shader("shaders/screen.vs", "shaders/taa.fs");
+    TAAUShader = new Shader("shaders/screen.vs", "shaders/taa.fs", "#define TAA_UPSAMPLE\n");
+
+    MaxSamples = 4;
+    glGetIntegerv(GL_MAX_SAMPLES, &MaxSamples);
+    History[0] = History[1] = nullptr;
     
-    // Initialize Framebuffers
-    MSAAFBO = new Framebuffer(width, height, true); // Multisampled
-    IntermediateFBO = new Framebuffer(width, height, false); // Normal texture
-    
-    // Initialize Ping Pong Framebuffers for Bloom
-    PingPongFBO[0] = new Framebuffer(width, height, false);
-    PingPongFBO[1] = new Framebuffer(width, height, false);
+    // Framebuffers are transient: every pass acquires what it needs from the pool each frame
+    Targets = new RenderTargetPool();
+    Graph = new RenderGraph(*Targets);
+
+    Bloom = new BloomRenderer();
+    DynRes = new DynamicResolution();
     
     InitRenderData();
 }
 
 PostProcessor::~PostProcessor() {
-    delete ScreenShader;
-    delete GlitchShader;
+    for (auto& variant : PostVariants) {
+        glDeleteProgram(variant.second->ID);
+        delete variant.second;
+    }
     delete BlurShader;
     delete BloomExtractShader;
-    delete MSAAFBO;
-    delete IntermediateFBO;
-    delete PingPongFBO[0];
-    delete PingPongFBO[1];
+    delete FXAAShader;
+    delete SMAAEdgeShader;
+    delete SMAAWeightShader;
+    delete SMAABlendShader;
+    delete TAAShader;
+    delete TAAUShader;
+    delete History[0];
+    delete History[1];
+    delete Bloom;
+    delete DynRes;
+    delete Graph;
+    delete Targets;
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
 }
@@ -58,106 +80,420 @@ void PostProcessor::InitRenderData() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
 }
 
-void PostProcessor::BeginRender() {
-    MSAAFBO->Bind();
-    glEnable(GL_DEPTH_TEST);
-    // [Modified] Darker Night Background
-    glClearColor(0.02f, 0.02f, 0.05f, 1.0f); 
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+static const char* BLOOM_PASS_NAME[2] = { "Bloom (Gaussian)", "Bloom (mip chain)" };
+
+static const char* AA_MODE_NAME[AA_MODE_COUNT] = { "Off", "MSAA 2x", "MSAA 4x", "MSAA 8x", "FXAA", "SMAA 1x", "TAA", "TAAU" };
+
+static int AASampleCount(AA_Mode mode) {
+    switch (mode) {
+    case AA_MSAA2: return 2;
+    case AA_MSAA4: return 4;
+    case AA_MSAA8: return 8;
+    default:       return 1;
+    }
 }
 
-void PostProcessor::EndRender(float time) {
-    // 1. Blit MSAA -> Intermediate
-    MSAAFBO->BlitTo(IntermediateFBO);
-    
-    // 2. Bloom Pipeline
-    if (UseBloom) {
-        // 2a. Extract Bright Colors
-        PingPongFBO[0]->Bind();
-        glClear(GL_COLOR_BUFFER_BIT);
-        BloomExtractShader->use();
-        BloomExtractShader->setInt("scene", 0);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, IntermediateFBO->TextureID);
-        glBindVertexArray(VAO);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        
-        // 2b. Gaussian Blur
-        bool horizontal = true, first_iteration = true;
-        unsigned int amount = 10;
-        BlurShader->use();
-        for (unsigned int i = 0; i < amount; i++)
-        {
-            PingPongFBO[horizontal]->Bind();
-            BlurShader->setInt("horizontal", horizontal);
-            
+// Low-discrepancy sequence for the TAA jitter: well spread sample positions over any 8 frames
+static float Halton(int index, int base) {
+    float f = 1.0f, result = 0.0f;
+    while (index > 0) {
+        f /= static_cast<float>(base);
+        result += f * static_cast<float>(index % base);
+        index /= base;
+    }
+    return result;
+}
+
+void PostProcessor::Render(float time, const std::function<void()>& drawScene) {
+    CGTP_PROFILE_SCOPE("PostProcessor::Render");
+    // Coalesced resize: whatever size came in last; old-size targets age out of the pool
+    Width = PendingWidth;
+    Height = PendingHeight;
+    ComputeRenderSize(RenderWidth, RenderHeight);
+    Targets->BeginFrame();
+    Graph->Reset();
+    UpdateHistoryTargets();
+
+    const AA_Mode aaMode = AAMode;
+    const bool postAA = aaMode == AA_FXAA || aaMode == AA_SMAA; // Run on the final LDR image
+    const bool temporal = aaMode == AA_TAA || aaMode == AA_TAAU;
+
+    // --- Resources ---
+    RenderTargetDesc sceneDesc;
+    sceneDesc.Width = RenderWidth;
+    sceneDesc.Height = RenderHeight;
+    sceneDesc.Format = GL_RGB16F; // HDR
+    sceneDesc.Samples = std::min(AASampleCount(aaMode), MaxSamples);
+    sceneDesc.Depth = true;       // The only target that draws geometry
+    sceneDesc.DepthTexture = temporal; // Reprojection reads depth
+    RenderGraph::Resource scene = Graph->CreateTarget("SceneColor", sceneDesc);
+
+    RenderTargetDesc bloomDesc;
+    bloomDesc.Width = BloomMode == BLOOM_MIPCHAIN ? RenderWidth / 2 : RenderWidth;
+    bloomDesc.Height = BloomMode == BLOOM_MIPCHAIN ? RenderHeight / 2 : RenderHeight;
+    bloomDesc.Format = BloomMode == BLOOM_MIPCHAIN ? GL_R11F_G11F_B10F : GL_RGB16F;
+    RenderGraph::Resource bloom = Graph->CreateTarget("Bloom", bloomDesc);
+
+    RenderGraph::Resource backbuffer;
+    if (OutputTarget) {
+        backbuffer = Graph->ImportTarget("Output", OutputTarget);
+        Graph->MarkOutput(backbuffer);
+    } else {
+        backbuffer = Graph->ImportBackbuffer("Backbuffer", Width, Height);
+    }
+
+    // With FXAA/SMAA the composite goes to an LDR target that the AA passes read
+    RenderGraph::Resource ldr = -1, edges = -1, weights = -1;
+    if (postAA) {
+        RenderTargetDesc ldrDesc;
+        ldrDesc.Width = Width;
+        ldrDesc.Height = Height;
+        ldrDesc.Format = GL_RGBA8;
+        ldr = Graph->CreateTarget("LDR", ldrDesc);
+    }
+    if (aaMode == AA_SMAA) {
+        RenderTargetDesc edgesDesc;
+        edgesDesc.Width = Width;
+        edgesDesc.Height = Height;
+        edgesDesc.Format = GL_RG8;
+        edges = Graph->CreateTarget("SMAAEdges", edgesDesc);
+        RenderTargetDesc weightsDesc = edgesDesc;
+        weightsDesc.Format = GL_RGBA8;
+        weights = Graph->CreateTarget("SMAAWeights", weightsDesc);
+    }
+
+    // TAA history is persistent: last frame's output is read, this frame's written
+    RenderGraph::Resource historyIn = -1, historyOut = -1;
+    if (temporal) {
+        historyIn = Graph->ImportTarget("TAAHistory.prev", History[1 - HistoryIndex]);
+        historyOut = Graph->ImportTarget("TAAHistory", History[HistoryIndex]);
+    }
+
+    // --- Passes (reads of a multisampled SceneColor get an automatic resolve) ---
+    Graph->AddPass("Scene", [&](RenderGraph::PassContext& ctx) {
+        ctx.BindTarget(scene);
+        glEnable(GL_DEPTH_TEST);
+        // [Modified] Darker Night Background
+        glClearColor(0.02f, 0.02f, 0.05f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        drawScene();
+    }).Write(scene);
+
+    // Post reads the HDR scene, or the TAA output (which lives on in the history).
+    // TAAU output is already at display size; bloom keeps reading the smaller scene.
+    RenderGraph::Resource hdr = scene;
+    RenderGraph::Resource bloomSource = scene;
+    if (temporal) {
+        Graph->AddPass(aaMode == AA_TAAU ? "TAAU" : "TAA", [&](RenderGraph::PassContext& ctx) {
+            ctx.BindTarget(historyOut);
+            glDisable(GL_DEPTH_TEST);
+            glm::vec2 jitter = GetProjectionJitter();
+            Shader* shader = aaMode == AA_TAAU ? TAAUShader : TAAShader;
+            shader->use();
+            shader->setInt("currentColor", 0);
+            shader->setInt("currentDepth", 1);
+            shader->setInt("historyColor", 2);
+            shader->setMat4("reprojection", PrevViewProjection * glm::inverse(ViewProjection));
+            shader->setVec2("jitterUV", jitter.x * 0.5f, jitter.y * 0.5f);
+            shader->setFloat("feedback", TAAFeedback);
+            shader->setBool("resetHistory", !HistoryValid);
             glActiveTexture(GL_TEXTURE0);
-            // Bind texture of other framebuffer (or extracted brights if first iteration)
-            // Wait, logic:
-            // Extract -> PingPong[0].
-            // Pass 1 (Hor): Read PingPong[0], Write PingPong[1].
-            // Pass 2 (Ver): Read PingPong[1], Write PingPong[0].
-            
-            // Correction: Extract writes to PingPong[0].
-            // First blur iteration: Use PingPong[0] as input? No, extraction output is input.
-            // Actually, simpler:
-            // Extract -> PingPong[0] texture.
-            // Loop:
-            //   Bind PingPong[1], Read PingPong[0], Blur Horizontal.
-            //   Bind PingPong[0], Read PingPong[1], Blur Vertical.
-            
-            glBindTexture(GL_TEXTURE_2D, first_iteration ? PingPongFBO[0]->TextureID : PingPongFBO[!horizontal]->TextureID); 
-            
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(scene));
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTarget(scene)->DepthTextureID);
+            glActiveTexture(GL_TEXTURE2);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(historyIn));
+            glBindVertexArray(VAO);
             glDrawArrays(GL_TRIANGLES, 0, 6);
-            horizontal = !horizontal;
-            if (first_iteration)
-                first_iteration = false;
+            RenderStats::AddDraw(2);
+        }).Read(scene).Read(historyIn).Write(historyOut);
+        hdr = historyOut;
+        if (aaMode == AA_TAA) bloomSource = historyOut;
+    }
+
+    // Always declared; culled when the composite does not read it
+    float bloomStrength = 1.0f;
+    Graph->AddPass(BLOOM_PASS_NAME[BloomMode], [&](RenderGraph::PassContext& ctx) {
+        if (BloomMode == BLOOM_MIPCHAIN) {
+            Bloom->Render(ctx.GetPool(), ctx.GetTexture(bloomSource), ctx.GetTarget(bloom), VAO);
+            // The upsample chain sums every level; normalize so intensity 1 is comparable to the Gaussian path
+            bloomStrength = BloomIntensity / static_cast<float>(Bloom->GetMipCount() > 0 ? Bloom->GetMipCount() : 1);
+        } else {
+            RenderGaussianBloom(ctx.GetTexture(bloomSource), ctx.GetTarget(bloom));
+            bloomStrength = BloomIntensity;
         }
+    }).Read(bloomSource).Write(bloom);
+
+    RenderGraph::Resource compositeOut = postAA ? ldr : backbuffer;
+    Graph->AddPass("Composite", [&](RenderGraph::PassContext& ctx) {
+        ctx.BindTarget(compositeOut);
+        Composite(time, ctx.GetTexture(hdr), UseBloom ? ctx.GetTexture(bloom) : 0, bloomStrength);
+    }).Read(hdr).Read(UseBloom ? bloom : -1).Write(compositeOut);
+
+    if (aaMode == AA_FXAA) {
+        Graph->AddPass("FXAA", [&](RenderGraph::PassContext& ctx) {
+            ctx.BindTarget(backbuffer);
+            FXAAShader->use();
+            FXAAShader->setInt("image", 0);
+            FXAAShader->setVec2("texelSize", 1.0f / Width, 1.0f / Height);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(ldr));
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::AddDraw(2);
+        }).Read(ldr).Write(backbuffer);
+    } else if (aaMode == AA_SMAA) {
+        // Edge and weight passes discard most pixels, so their targets start cleared
+        Graph->AddPass("SMAA Edges", [&](RenderGraph::PassContext& ctx) {
+            ctx.BindTarget(edges);
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            SMAAEdgeShader->use();
+            SMAAEdgeShader->setInt("image", 0);
+            SMAAEdgeShader->setFloat("threshold", SMAAThreshold);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(ldr));
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::AddDraw(2);
+        }).Read(ldr).Write(edges);
+
+        Graph->AddPass("SMAA Weights", [&](RenderGraph::PassContext& ctx) {
+            ctx.BindTarget(weights);
+            glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            SMAAWeightShader->use();
+            SMAAWeightShader->setInt("edgesTex", 0);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(edges));
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::AddDraw(2);
+        }).Read(edges).Write(weights);
+
+        Graph->AddPass("SMAA Blend", [&](RenderGraph::PassContext& ctx) {
+            ctx.BindTarget(backbuffer);
+            SMAABlendShader->use();
+            SMAABlendShader->setInt("image", 0);
+            SMAABlendShader->setInt("weightsTex", 1);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(ldr));
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, ctx.GetTexture(weights));
+            glBindVertexArray(VAO);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            RenderStats::AddDraw(2);
+        }).Read(ldr).Read(weights).Write(backbuffer);
     }
 
-    // 3. Render Quad to Screen
-    glBindFramebuffer(GL_FRAMEBUFFER, 0); // Back to default
-    glDisable(GL_DEPTH_TEST); // We don't care about depth for the screen quad
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f); 
+    Graph->Compile();
+    Graph->Execute();
+    Targets->EndFrame();
+
+    if (temporal) {
+        HistoryIndex = 1 - HistoryIndex;
+        HistoryValid = true;
+    }
+    PrevViewProjection = ViewProjection;
+    FrameIndex++;
+
+    AAStats& stats = AAMeasured[aaMode];
+    stats.Measured = true;
+    stats.TargetBytes = Targets->GetPeakInUseBytes();
+    if (temporal)
+        stats.TargetBytes += History[0]->GetMemoryBytes() + History[1]->GetMemoryBytes();
+    stats.FrameGpuMs = Graph->GetFrameGpuMs();
+    stats.AAGpuMs = GetAAPassGpuMs();
+
+    // Next frame's render size
+    DynRes->Update(stats.FrameGpuMs);
+}
+
+void PostProcessor::ComputeRenderSize(int& width, int& height) const {
+    float scale = DynRes->GetScale();
+    if (AAMode == AA_TAAU) {
+        // TAAU reconstructs the display size, so it always renders below it
+        float taauScale = std::min(std::max(TAAUScale, 0.5f), 0.77f);
+        scale = DynRes->Enabled ? std::min(scale, taauScale) : taauScale;
+    }
+    width = std::max(1, static_cast<int>(PendingWidth * scale + 0.5f));
+    height = std::max(1, static_cast<int>(PendingHeight * scale + 0.5f));
+}
+
+void PostProcessor::UpdateHistoryTargets() {
+    // TAA history outlives the frame, so it is owned here rather than by the pool.
+    // Dropped outside TAA; a new size or re-entering TAA starts without history.
+    // TAAU keeps it at the display size, TAA at the render size.
+    if (AAMode != AA_TAA && AAMode != AA_TAAU) {
+        delete History[0];
+        delete History[1];
+        History[0] = History[1] = nullptr;
+        HistoryValid = false;
+        return;
+    }
+    int width = AAMode == AA_TAAU ? static_cast<int>(Width) : RenderWidth;
+    int height = AAMode == AA_TAAU ? static_cast<int>(Height) : RenderHeight;
+    if (History[0] && History[0]->Width == width && History[0]->Height == height)
+        return;
+    for (int i = 0; i < 2; i++) {
+        delete History[i];
+        History[i] = new Framebuffer(width, height, false, GL_RGB16F, false);
+    }
+    HistoryValid = false;
+}
+
+float PostProcessor::GetAAPassGpuMs() const {
+    switch (AAMode) {
+    case AA_MSAA2:
+    case AA_MSAA4:
+    case AA_MSAA8: return Graph->GetPassGpuMs("Resolve SceneColor");
+    case AA_FXAA:  return Graph->GetPassGpuMs("FXAA");
+    case AA_SMAA:  return Graph->GetPassGpuMs("SMAA Edges") + Graph->GetPassGpuMs("SMAA Weights") + Graph->GetPassGpuMs("SMAA Blend");
+    case AA_TAA:   return Graph->GetPassGpuMs("TAA");
+    case AA_TAAU:  return Graph->GetPassGpuMs("TAAU");
+    default:       return 0.0f;
+    }
+}
+
+glm::vec2 PostProcessor::GetProjectionJitter() const {
+    if (AAMode != AA_TAA && AAMode != AA_TAAU) return glm::vec2(0.0f);
+    // Halton(2, 3) centered on the pixel; one (render) pixel is 2 / size in NDC.
+    // 8 phases for TAA; TAAU spreads samples over more output pixels, so it cycles through 16
+    int phases = AAMode == AA_TAAU ? 16 : 8;
+    int index = static_cast<int>(FrameIndex % phases) + 1;
+    glm::vec2 pixels(Halton(index, 2) - 0.5f, Halton(index, 3) - 0.5f);
+    int width, height;
+    ComputeRenderSize(width, height);
+    return pixels * glm::vec2(2.0f / width, 2.0f / height);
+}
+
+const char* PostProcessor::GetAAModeName(AA_Mode mode) {
+    return mode >= 0 && mode < AA_MODE_COUNT ? AA_MODE_NAME[mode] : "?";
+}
+
+void PostProcessor::RenderGaussianBloom(unsigned int sourceTexture, Framebuffer* output) {
+    // Ping-pong between the output and one temporary of the same kind
+    RenderTargetDesc desc;
+    desc.Width = output->Width;
+    desc.Height = output->Height;
+    desc.Format = output->InternalFormat;
+    Framebuffer* pingPong[2] = { output, Targets->Acquire(desc) };
+
+    // 2a. Extract Bright Colors
+    GpuProfiler::Begin("Extract");
+    pingPong[0]->Bind();
+    glDisable(GL_DEPTH_TEST);
     glClear(GL_COLOR_BUFFER_BIT);
+    BloomExtractShader->use();
+    BloomExtractShader->setInt("scene", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sourceTexture);
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    RenderStats::AddDraw(2);
+    GpuProfiler::End();
+
+    // 2b. Gaussian Blur
+    // Extract -> pingPong[0]. Pass 1 (Hor): read [0], write [1]. Pass 2 (Ver): read [1], write [0].
+    // 10 passes (even), so the result ends up in pingPong[0].
+    bool horizontal = true;
+    unsigned int amount = 10;
+    GpuProfiler::Scope blurScope("Blur");
+    BlurShader->use();
+    for (unsigned int i = 0; i < amount; i++)
+    {
+        pingPong[horizontal]->Bind();
+        BlurShader->setInt("horizontal", horizontal);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, pingPong[!horizontal]->TextureID);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        RenderStats::AddDraw(2);
+        horizontal = !horizontal;
+    }
+    Targets->Release(pingPong[1]);
+}
+
+float PostProcessor::GetBloomGpuMs(Bloom_Mode mode) const {
+    return Graph->GetPassGpuMs(BLOOM_PASS_NAME[mode]);
+}
+
+unsigned int PostProcessor::GetFeatureMask() const {
+    unsigned int features = 0;
+    if (UseBloom) features |= POST_BLOOM;
+    if (UseGlitch) features |= POST_GLITCH;
+    if (UseRain) features |= POST_RAIN;
+    if (UseTonemap) features |= POST_TONEMAP;
+    if (UseVignette) features |= POST_VIGNETTE;
+    // TAAU hands the composite a display-size image already
+    if (BicubicUpscale && AAMode != AA_TAAU && (RenderWidth < static_cast<int>(Width) || RenderHeight < static_cast<int>(Height)))
+        features |= POST_UPSCALE;
+    return features;
+}
+
+Shader* PostProcessor::GetPostShader(unsigned int features) {
+    auto it = PostVariants.find(features);
+    if (it != PostVariants.end())
+        return it->second;
+
+    std::string defines;
+    if (features & POST_BLOOM) defines += "#define USE_BLOOM\n";
+    if (features & POST_GLITCH) defines += "#define USE_GLITCH\n";
+    if (features & POST_RAIN) defines += "#define USE_RAIN\n";
+    if (features & POST_TONEMAP) defines += "#define USE_TONEMAP\n";
+    if (features & POST_VIGNETTE) defines += "#define USE_VIGNETTE\n";
+    if (features & POST_UPSCALE) defines += "#define USE_UPSCALE\n";
+
+    // Compilation runs in the background when the driver supports it; Render (its composite pass)
+    // polls isReady() and keeps drawing with ActivePost until the new variant is linked
+    Shader* shader = new Shader("shaders/screen.vs", "shaders/post.fs", defines);
+    PostVariants[features] = shader;
+    return shader;
+}
 
-    Shader* shaderToUse = UseGlitch ? GlitchShader : ScreenShader;
+void PostProcessor::Composite(float time, unsigned int sceneTexture, unsigned int bloomTexture, float bloomStrength) {
+    glDisable(GL_DEPTH_TEST); // We don't care about depth for the screen quad
+
+    // All enabled effects fuse into this one pass; disabled ones are compiled out of the variant
+    unsigned int features = GetFeatureMask();
+    Shader* shaderToUse = GetPostShader(features);
+    if (shaderToUse->isReady() || !ActivePost) {
+        ActivePost = shaderToUse;
+        ActiveFeatures = features;
+    } else {
+        // Just toggled and still compiling: keep the previous look for a few frames instead of stalling
+        shaderToUse = ActivePost;
+        features = ActiveFeatures;
+    }
     shaderToUse->use();
     shaderToUse->setInt("screenTexture", 0);
-    shaderToUse->setInt("bloomBlur", 1);
-    shaderToUse->setInt("bloom", UseBloom);
-    shaderToUse->setFloat("exposure", 1.0f); // Simple exposure
-
-    if (UseGlitch) {
+    if (features & (POST_GLITCH | POST_RAIN))
         shaderToUse->setFloat("time", time);
+    if (features & POST_BLOOM) {
+        shaderToUse->setInt("bloomBlur", 1);
+        shaderToUse->setFloat("bloomStrength", bloomStrength);
     }
+    if (features & POST_TONEMAP)
+        shaderToUse->setFloat("exposure", Exposure);
+    if (features & POST_VIGNETTE)
+        shaderToUse->setFloat("vignetteStrength", VignetteStrength);
 
+    // The quad covers every pixel, so the backbuffer needs no clear
     glBindVertexArray(VAO);
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, IntermediateFBO->TextureID);
+    glBindTexture(GL_TEXTURE_2D, sceneTexture);
     
-    glActiveTexture(GL_TEXTURE1);
-    // The last write was to PingPong[!horizontal] (because we flipped horizontal at end of loop)
-    // Actually, simplest is to just blindly use PingPong[0] or [1] depending on logic.
-    // Loop ran 10 times. Even number.
-    // Iter 0: Reads [0], writes [1]. hor=false.
-    // Iter 1: Reads [1], writes [0]. hor=true.
-    // ...
-    // Iter 9: Reads [1], writes [0].
-    // So result is in PingPong[0].
-    if (UseBloom)
-        glBindTexture(GL_TEXTURE_2D, PingPongFBO[0]->TextureID);
-    else
-        glBindTexture(GL_TEXTURE_2D, 0); // Bind nothing or black
+    if (features & POST_BLOOM) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, bloomTexture);
+    }
 
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    RenderStats::AddDraw(2);
 }
 
 void PostProcessor::UpdateSize(int width, int height) {
-    Width = width;
-    Height = height;
-    MSAAFBO->Rescale(width, height);
-    IntermediateFBO->Rescale(width, height);
-    PingPongFBO[0]->Rescale(width, height);
-    PingPongFBO[1]->Rescale(width, height);
+    // Minimized windows report 0x0; keep the last real size
+    if (width <= 0 || height <= 0) return;
+    PendingWidth = width;
+    PendingHeight = height;
 }
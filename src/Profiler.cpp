@@ -0,0 +1,153 @@
+#include "Profiler.h"
+
+#include <iostream>
+
+#if defined(CGTP_ENABLE_PROFILER)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+const bool Profiler::CompiledIn = true;
+thread_local Profiler::ThreadBuffer* Profiler::localBuffer = nullptr;
+
+// Buffers are never freed: a capture may read a ring while its thread exits
+static std::mutex buffersMutex;
+static std::vector<Profiler::ThreadBuffer*> allBuffers;
+static std::vector<Profiler::ThreadBuffer*> freeBuffers;
+
+// TSC <-> wall clock reference, taken at startup; captures calibrate against it
+struct ClockReference {
+    uint64_t Ticks;
+    std::chrono::steady_clock::time_point Time;
+    ClockReference() : Ticks(Profiler::Ticks()), Time(std::chrono::steady_clock::now()) {}
+};
+static const ClockReference startReference;
+
+uint64_t Profiler::Ticks() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Returns the buffer to the free list when its thread exits
+struct BufferReturner {
+    Profiler::ThreadBuffer* Buffer = nullptr;
+    ~BufferReturner() {
+        if (!Buffer) return;
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        freeBuffers.push_back(Buffer);
+    }
+};
+
+Profiler::ThreadBuffer* Profiler::AcquireBuffer() {
+    static thread_local BufferReturner returner;
+    ThreadBuffer* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        if (!freeBuffers.empty()) {
+            buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        } else {
+            buffer = new ThreadBuffer();
+            buffer->Lane = static_cast<uint32_t>(allBuffers.size() + 1);
+            allBuffers.push_back(buffer);
+        }
+        // A reused ring must not keep the previous thread's name
+        std::snprintf(buffer->Name, sizeof(buffer->Name), "Thread %u", buffer->Lane);
+    }
+    buffer->Depth = 0;
+    returner.Buffer = buffer;
+    localBuffer = buffer;
+    return buffer;
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ThreadBuffer* buffer = LocalBuffer();
+    std::strncpy(buffer->Name, name, sizeof(buffer->Name) - 1);
+}
+
+bool Profiler::SaveCapture(const std::string& path) {
+    // Calibrate ticks against the clock over the whole run (at least 1 ms)
+    uint64_t nowTicks;
+    std::chrono::steady_clock::time_point now;
+    do {
+        nowTicks = Ticks();
+        now = std::chrono::steady_clock::now();
+    } while (now - startReference.Time < std::chrono::milliseconds(1));
+    const double elapsedUs = std::chrono::duration<double, std::micro>(now - startReference.Time).count();
+    const double ticksPerUs = static_cast<double>(nowTicks - startReference.Ticks) / elapsedUs;
+
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "ERROR::PROFILER:: Cannot write " << path << std::endl;
+        return false;
+    }
+
+    std::vector<Event> events;
+    size_t total = 0;
+    char line[512];
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (ThreadBuffer* buffer : allBuffers) {
+        // Copy the ring without stopping the writer: take what was published, then drop
+        // anything the writer may have overwritten while we were copying
+        const uint64_t head = buffer->Head.load(std::memory_order_acquire);
+        const uint64_t begin = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (uint64_t i = begin; i < head; i++)
+            events.push_back(buffer->Events[i & (EVENTS_PER_THREAD - 1)]);
+        const uint64_t headAfter = buffer->Head.load(std::memory_order_acquire);
+        const uint64_t firstValid = headAfter + 1 > EVENTS_PER_THREAD ? headAfter + 1 - EVENTS_PER_THREAD : 0;
+        const size_t skip = static_cast<size_t>(std::min<uint64_t>(firstValid > begin ? firstValid - begin : 0, events.size()));
+
+        std::snprintf(line, sizeof(line),
+            "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",", buffer->Lane, buffer->Name);
+        out << line;
+        first = false;
+
+        for (size_t i = skip; i < events.size(); i++) {
+            const Event& e = events[i];
+            if (e.Begin < startReference.Ticks) continue;
+            const double ts = (e.Begin - startReference.Ticks) / ticksPerUs;
+            const double dur = e.End > e.Begin ? (e.End - e.Begin) / ticksPerUs : 0.0;
+            std::snprintf(line, sizeof(line),
+                ",\n{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}",
+                e.Name, buffer->Lane, ts, dur, e.Depth);
+            out << line;
+            total++;
+        }
+    }
+    out << "\n]}\n";
+    std::cout << "CPU profiler: wrote " << total << " scopes from " << allBuffers.size() << " threads to " << path
+              << " (" << ticksPerUs << " ticks/us)" << std::endl;
+    return true;
+}
+
+#else
+
+const bool Profiler::CompiledIn = false;
+
+bool Profiler::SaveCapture(const std::string& path) {
+    std::cout << "CPU profiler is compiled out; configure with -DCGTP_ENABLE_PROFILER=ON (or a Debug build) to capture "
+              << path << std::endl;
+    return false;
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include "RenderCommands.h"
+#include "Shader.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+enum CommandType : unsigned short {
+    CMD_USE_SHADER,
+    CMD_SET_INT,
+    CMD_SET_FLOAT,
+    CMD_SET_VEC3,
+    CMD_SET_MAT4,
+    CMD_SET_PROJECTION,
+    CMD_ACTIVE_TEXTURE,
+    CMD_BIND_TEXTURE,
+    CMD_BIND_VERTEX_ARRAY,
+    CMD_DRAW_ELEMENTS,
+    CMD_DRAW_ARRAYS_INSTANCED,
+    CMD_BUFFER_DATA
+};
+
+// Every command: header, fixed part (one of the structs below), tail (name or upload)
+struct CommandHeader {
+    uint16_t Type;
+    uint16_t FixedSize;
+    uint32_t TailSize;
+};
+
+struct UseShaderCmd { Shader* Target; };
+struct IntCmd { GLuint Program; GLint Value; };
+struct FloatCmd { GLuint Program; float Value; };
+struct Vec3Cmd { GLuint Program; glm::vec3 Value; };
+struct Mat4Cmd { GLuint Program; glm::mat4 Value; };
+struct UnitCmd { GLuint Value; };
+struct DrawElementsCmd { GLenum Mode; GLsizei Count; GLenum Type; };
+struct DrawInstancedCmd { GLenum Mode; GLint First; GLsizei Count; GLsizei Instances; };
+struct BufferDataCmd { GLenum Target; GLuint Buffer; GLenum Usage; };
+
+// The byte buffer gives no alignment: copy out
+template <typename T>
+T Read(const unsigned char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+}
+
+RenderCommandBuffer::RenderCommandBuffer(bool immediate) : immediate(immediate), commandCount(0) {
+}
+
+RenderCommandBuffer& RenderCommandBuffer::Immediate() {
+    static RenderCommandBuffer buffer(true);
+    return buffer;
+}
+
+void RenderCommandBuffer::UseShader(Shader& shader) {
+    UseShaderCmd cmd = { &shader };
+    Emit(CMD_USE_SHADER, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::SetInt(const Shader& shader, const std::string& name, int value) {
+    IntCmd cmd = { shader.ID, value };
+    Emit(CMD_SET_INT, &cmd, sizeof(cmd), name.c_str(), name.size() + 1);
+}
+
+void RenderCommandBuffer::SetFloat(const Shader& shader, const std::string& name, float value) {
+    FloatCmd cmd = { shader.ID, value };
+    Emit(CMD_SET_FLOAT, &cmd, sizeof(cmd), name.c_str(), name.size() + 1);
+}
+
+void RenderCommandBuffer::SetVec3(const Shader& shader, const std::string& name, const glm::vec3& value) {
+    Vec3Cmd cmd = { shader.ID, value };
+    Emit(CMD_SET_VEC3, &cmd, sizeof(cmd), name.c_str(), name.size() + 1);
+}
+
+void RenderCommandBuffer::SetMat4(const Shader& shader, const std::string& name, const glm::mat4& value) {
+    Mat4Cmd cmd = { shader.ID, value };
+    Emit(CMD_SET_MAT4, &cmd, sizeof(cmd), name.c_str(), name.size() + 1);
+}
+
+void RenderCommandBuffer::SetProjection(const Shader& shader, const std::string& name, const glm::mat4& projection) {
+    Mat4Cmd cmd = { shader.ID, projection };
+    Emit(CMD_SET_PROJECTION, &cmd, sizeof(cmd), name.c_str(), name.size() + 1);
+}
+
+void RenderCommandBuffer::ActiveTexture(unsigned int unit) {
+    UnitCmd cmd = { unit };
+    Emit(CMD_ACTIVE_TEXTURE, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::BindTexture(unsigned int texture) {
+    UnitCmd cmd = { texture };
+    Emit(CMD_BIND_TEXTURE, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::BindVertexArray(unsigned int vao) {
+    UnitCmd cmd = { vao };
+    Emit(CMD_BIND_VERTEX_ARRAY, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::DrawElements(GLenum mode, GLsizei count, GLenum type) {
+    DrawElementsCmd cmd = { mode, count, type };
+    Emit(CMD_DRAW_ELEMENTS, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    DrawInstancedCmd cmd = { mode, first, count, instances };
+    Emit(CMD_DRAW_ARRAYS_INSTANCED, &cmd, sizeof(cmd), nullptr, 0);
+}
+
+void RenderCommandBuffer::BufferData(GLenum target, unsigned int buffer, const void* data, size_t bytes, GLenum usage) {
+    BufferDataCmd cmd = { target, buffer, usage };
+    Emit(CMD_BUFFER_DATA, &cmd, sizeof(cmd), data, bytes);
+}
+
+void RenderCommandBuffer::Replay() {
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+        CommandHeader header = Read<CommandHeader>(&bytes[offset]);
+        const unsigned char* fixed = bytes.data() + offset + sizeof(CommandHeader);
+        Execute(header.Type, fixed, fixed + header.FixedSize, header.TailSize);
+        offset += sizeof(CommandHeader) + header.FixedSize + header.TailSize;
+    }
+}
+
+void RenderCommandBuffer::Clear() {
+    bytes.clear();
+    commandCount = 0;
+}
+
+void RenderCommandBuffer::Emit(unsigned short type, const void* fixed, size_t fixedSize, const void* tail, size_t tailSize) {
+    commandCount++;
+    if (immediate) {
+        Execute(type, static_cast<const unsigned char*>(fixed), static_cast<const unsigned char*>(tail), tailSize);
+        return;
+    }
+    CommandHeader header = { type, static_cast<uint16_t>(fixedSize), static_cast<uint32_t>(tailSize) };
+    size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(header) + fixedSize + tailSize);
+    unsigned char* out = bytes.data() + offset;
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), fixed, fixedSize);
+    if (tailSize > 0)
+        std::memcpy(out + sizeof(header) + fixedSize, tail, tailSize);
+}
+
+void RenderCommandBuffer::Execute(unsigned short type, const unsigned char* fixed, const unsigned char* tail, size_t tailSize) {
+    const char* name = reinterpret_cast<const char*>(tail);
+    switch (type) {
+    case CMD_USE_SHADER:
+        Read<UseShaderCmd>(fixed).Target->use();
+        break;
+    case CMD_SET_INT: {
+        IntCmd cmd = Read<IntCmd>(fixed);
+        glUniform1i(glGetUniformLocation(cmd.Program, name), cmd.Value);
+        break;
+    }
+    case CMD_SET_FLOAT: {
+        FloatCmd cmd = Read<FloatCmd>(fixed);
+        glUniform1f(glGetUniformLocation(cmd.Program, name), cmd.Value);
+        break;
+    }
+    case CMD_SET_VEC3: {
+        Vec3Cmd cmd = Read<Vec3Cmd>(fixed);
+        glUniform3fv(glGetUniformLocation(cmd.Program, name), 1, &cmd.Value[0]);
+        break;
+    }
+    case CMD_SET_MAT4:
+    case CMD_SET_PROJECTION: {
+        Mat4Cmd cmd = Read<Mat4Cmd>(fixed);
+        if (type == CMD_SET_PROJECTION) {
+            // Same shift as Camera::GetProjectionMatrix
+            cmd.Value[2][0] -= ProjectionJitter.x;
+            cmd.Value[2][1] -= ProjectionJitter.y;
+        }
+        glUniformMatrix4fv(glGetUniformLocation(cmd.Program, name), 1, GL_FALSE, &cmd.Value[0][0]);
+        break;
+    }
+    case CMD_ACTIVE_TEXTURE:
+        glActiveTexture(GL_TEXTURE0 + Read<UnitCmd>(fixed).Value);
+        break;
+    case CMD_BIND_TEXTURE:
+        glBindTexture(GL_TEXTURE_2D, Read<UnitCmd>(fixed).Value);
+        break;
+    case CMD_BIND_VERTEX_ARRAY:
+        glBindVertexArray(Read<UnitCmd>(fixed).Value);
+        break;
+    case CMD_DRAW_ELEMENTS: {
+        DrawElementsCmd cmd = Read<DrawElementsCmd>(fixed);
+        glDrawElements(cmd.Mode, cmd.Count, cmd.Type, 0);
+        break;
+    }
+    case CMD_DRAW_ARRAYS_INSTANCED: {
+        DrawInstancedCmd cmd = Read<DrawInstancedCmd>(fixed);
+        glDrawArraysInstanced(cmd.Mode, cmd.First, cmd.Count, cmd.Instances);
+        break;
+    }
+    case CMD_BUFFER_DATA: {
+        BufferDataCmd cmd = Read<BufferDataCmd>(fixed);
+        glBindBuffer(cmd.Target, cmd.Buffer);
+        glBufferData(cmd.Target, static_cast<GLsizeiptr>(tailSize), nullptr, cmd.Usage);
+        glBufferSubData(cmd.Target, 0, static_cast<GLsizeiptr>(tailSize), tail);
+        break;
+    }
+    }
+}
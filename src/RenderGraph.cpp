@@ -0,0 +1,293 @@
+#include "RenderGraph.h"
+#include "GpuProfiler.h"
+#include "Profiler.h"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+// --- PassBuilder / PassContext ---
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(Resource resource) {
+    if (resource >= 0) graph->passes[pass].Reads.push_back(resource);
+    return *this;
+}
+
+RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(Resource resource) {
+    if (resource >= 0) graph->passes[pass].Writes.push_back(resource);
+    return *this;
+}
+
+Framebuffer* RenderGraph::PassContext::GetTarget(Resource resource) const {
+    return graph->resources[graph->Actual(pass, resource)].Target;
+}
+
+unsigned int RenderGraph::PassContext::GetTexture(Resource resource) const {
+    Framebuffer* target = GetTarget(resource);
+    return target ? target->TextureID : 0;
+}
+
+void RenderGraph::PassContext::BindTarget(Resource resource) const {
+    const ResourceNode& node = graph->resources[resource];
+    if (node.Imported && !node.Target) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, node.Desc.Width, node.Desc.Height);
+    } else {
+        node.Target->Bind();
+    }
+}
+
+// --- RenderGraph ---
+
+RenderGraph::RenderGraph(RenderTargetPool& pool) : pool(pool), culledCount(0), compiled(false) {
+}
+
+RenderGraph::~RenderGraph() {
+    for (auto& timer : timers)
+        delete timer.second;
+}
+
+void RenderGraph::Reset() {
+    resources.clear();
+    passes.clear();
+    culledCount = 0;
+    compiled = false;
+}
+
+RenderGraph::Resource RenderGraph::CreateTarget(const std::string& name, const RenderTargetDesc& desc) {
+    ResourceNode node;
+    node.Name = name;
+    node.Desc = desc;
+    node.Imported = false;
+    node.Output = false;
+    node.FirstUse = node.LastUse = -1;
+    node.Target = nullptr;
+    resources.push_back(node);
+    return static_cast<Resource>(resources.size() - 1);
+}
+
+RenderGraph::Resource RenderGraph::ImportBackbuffer(const std::string& name, int width, int height) {
+    RenderTargetDesc desc;
+    desc.Width = width;
+    desc.Height = height;
+    desc.Format = GL_RGBA8;
+    Resource r = CreateTarget(name, desc);
+    resources[r].Imported = true;
+    resources[r].Output = true;
+    return r;
+}
+
+RenderGraph::Resource RenderGraph::ImportTarget(const std::string& name, Framebuffer* target) {
+    RenderTargetDesc desc;
+    desc.Width = target->Width;
+    desc.Height = target->Height;
+    desc.Format = target->InternalFormat;
+    desc.Samples = target->Samples;
+    desc.Depth = target->HasDepth;
+    desc.DepthTexture = target->DepthIsTexture;
+    Resource r = CreateTarget(name, desc);
+    resources[r].Imported = true;
+    resources[r].Target = target;
+    return r;
+}
+
+void RenderGraph::MarkOutput(Resource resource) {
+    if (resource >= 0) resources[resource].Output = true;
+}
+
+RenderGraph::PassBuilder RenderGraph::AddPass(const std::string& name, ExecuteFn execute) {
+    PassNode node;
+    node.Name = name;
+    node.Execute = execute;
+    node.Culled = false;
+    passes.push_back(node);
+    return PassBuilder(this, static_cast<int>(passes.size() - 1));
+}
+
+RenderGraph::Resource RenderGraph::Actual(int pass, Resource resource) const {
+    for (const auto& redirect : passes[pass].Redirects)
+        if (redirect.first == resource) return redirect.second;
+    return resource;
+}
+
+void RenderGraph::InsertResolves() {
+    // resolvedCopy[r]: single-sample copy of r valid since r's last write (-1 = stale)
+    std::vector<Resource> resolvedCopy(resources.size(), -1);
+    std::vector<PassNode> scheduled;
+    scheduled.reserve(passes.size());
+
+    for (PassNode& pass : passes) {
+        for (Resource r : pass.Reads) {
+            if (resources[r].Desc.Samples <= 1) continue;
+            if (resolvedCopy[r] < 0) {
+                RenderTargetDesc desc = resources[r].Desc;
+                desc.Samples = 1;
+                desc.Depth = false; // Only color is sampled
+                Resource resolved = CreateTarget(resources[r].Name + ".resolved", desc);
+                resolvedCopy.push_back(-1);
+                resolvedCopy[r] = resolved;
+
+                PassNode resolve;
+                resolve.Name = "Resolve " + resources[r].Name;
+                resolve.Reads.push_back(r);
+                resolve.Writes.push_back(resolved);
+                resolve.Culled = false;
+                resolve.Execute = [r, resolved](PassContext& ctx) {
+                    ctx.GetTarget(r)->BlitTo(ctx.GetTarget(resolved));
+                };
+                scheduled.push_back(resolve);
+            }
+            pass.Redirects.push_back(std::make_pair(r, resolvedCopy[r]));
+        }
+        // The pass reads through its redirects
+        for (Resource& r : pass.Reads)
+            for (const auto& redirect : pass.Redirects)
+                if (redirect.first == r) r = redirect.second;
+        for (Resource w : pass.Writes)
+            resolvedCopy[w] = -1;
+        scheduled.push_back(pass);
+    }
+    passes.swap(scheduled);
+}
+
+void RenderGraph::CullPasses() {
+    // Walk back from the outputs: a pass survives if something needed is written by it
+    std::vector<bool> needed(resources.size(), false);
+    for (size_t r = 0; r < resources.size(); r++)
+        needed[r] = resources[r].Output;
+
+    culledCount = 0;
+    for (int p = static_cast<int>(passes.size()) - 1; p >= 0; p--) {
+        PassNode& pass = passes[p];
+        bool alive = false;
+        for (Resource w : pass.Writes)
+            if (needed[w]) alive = true;
+        pass.Culled = !alive;
+        if (!alive) {
+            culledCount++;
+            continue;
+        }
+        for (Resource r : pass.Reads)
+            needed[r] = true;
+    }
+}
+
+void RenderGraph::ComputeLifetimes() {
+    for (ResourceNode& node : resources)
+        node.FirstUse = node.LastUse = -1;
+
+    for (int p = 0; p < static_cast<int>(passes.size()); p++) {
+        if (passes[p].Culled) continue;
+        auto touch = [this, p](Resource r) {
+            ResourceNode& node = resources[r];
+            if (node.FirstUse < 0) node.FirstUse = p;
+            node.LastUse = p;
+        };
+        for (Resource r : passes[p].Reads) touch(r);
+        for (Resource w : passes[p].Writes) touch(w);
+    }
+}
+
+void RenderGraph::Compile() {
+    CGTP_PROFILE_SCOPE("RenderGraph::Compile");
+    InsertResolves();
+    CullPasses();
+    ComputeLifetimes();
+    compiled = true;
+}
+
+void RenderGraph::Execute() {
+    CGTP_PROFILE_SCOPE("RenderGraph::Execute");
+    if (!compiled) Compile();
+
+    for (int p = 0; p < static_cast<int>(passes.size()); p++) {
+        PassNode& pass = passes[p];
+        if (pass.Culled) continue;
+
+        for (ResourceNode& node : resources)
+            if (!node.Imported && node.FirstUse == p)
+                node.Target = pool.Acquire(node.Desc);
+
+        GpuTimer*& timer = timers[pass.Name];
+        if (!timer) timer = new GpuTimer();
+        timer->Begin();
+        {
+            GpuProfiler::Scope scope(pass.Name);
+            PassContext ctx(this, p);
+            pass.Execute(ctx);
+        }
+        timer->End();
+
+        // Dead after this pass: back to the pool, a later pass may get the same memory
+        for (ResourceNode& node : resources) {
+            if (!node.Imported && node.LastUse == p) {
+                pool.Release(node.Target);
+                node.Target = nullptr;
+            }
+        }
+    }
+}
+
+static const char* FormatName(GLenum format) {
+    switch (format) {
+    case GL_RGB16F:         return "RGB16F";
+    case GL_RGBA16F:        return "RGBA16F";
+    case GL_R11F_G11F_B10F: return "R11G11B10F";
+    case GL_RGBA8:          return "RGBA8";
+    case GL_RGB8:           return "RGB8";
+    case GL_R8:             return "R8";
+    case GL_RG8:            return "RG8";
+    case GL_RG16F:          return "RG16F";
+    case GL_R16F:           return "R16F";
+    case GL_R32F:           return "R32F";
+    default:                return "?";
+    }
+}
+
+std::string RenderGraph::Dump() const {
+    std::ostringstream out;
+    out << "Render graph: " << passes.size() << " passes (" << culledCount << " culled), "
+        << resources.size() << " resources\n";
+
+    char line[256];
+    for (size_t p = 0; p < passes.size(); p++) {
+        const PassNode& pass = passes[p];
+        if (pass.Culled)
+            std::snprintf(line, sizeof(line), "x %2d %-22s  culled   ", static_cast<int>(p), pass.Name.c_str());
+        else
+            std::snprintf(line, sizeof(line), "  %2d %-22s %7.3f ms", static_cast<int>(p), pass.Name.c_str(), GetPassGpuMs(pass.Name));
+        out << line;
+        if (!pass.Reads.empty()) {
+            out << "  reads";
+            for (Resource r : pass.Reads) out << " " << resources[r].Name;
+        }
+        if (!pass.Writes.empty()) {
+            out << "  writes";
+            for (Resource w : pass.Writes) out << " " << resources[w].Name;
+        }
+        out << "\n";
+    }
+
+    for (const ResourceNode& node : resources) {
+        std::snprintf(line, sizeof(line), "  %-20s %4dx%-4d %-10s x%d%s", node.Name.c_str(),
+            node.Desc.Width, node.Desc.Height, node.Imported && !node.Target ? "backbuffer" : FormatName(node.Desc.Format),
+            node.Desc.Samples, node.Desc.Depth ? (node.Desc.DepthTexture ? " +depth(tex)" : " +depth") : "");
+        out << line;
+        if (node.Imported && node.Target) out << "  imported";
+        if (node.FirstUse < 0) out << "  unused\n";
+        else out << "  passes " << node.FirstUse << ".." << node.LastUse << "\n";
+    }
+    return out.str();
+}
+
+float RenderGraph::GetPassGpuMs(const std::string& name) const {
+    auto it = timers.find(name);
+    return it == timers.end() ? 0.0f : it->second->GetMs();
+}
+
+float RenderGraph::GetFrameGpuMs() const {
+    float ms = 0.0f;
+    for (const PassNode& pass : passes)
+        if (!pass.Culled) ms += GetPassGpuMs(pass.Name);
+    return ms;
+}
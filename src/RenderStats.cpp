@@ -0,0 +1,7 @@
+#include "RenderStats.h"
+
+std::atomic<int> RenderStats::drawCalls(0);
+std::atomic<long long> RenderStats::triangles(0);
+std::atomic<int> RenderStats::meshesTested(0);
+std::atomic<int> RenderStats::meshesCulled(0);
+RenderStats::Counters RenderStats::last;
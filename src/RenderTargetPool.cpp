@@ -0,0 +1,88 @@
+#include "RenderTargetPool.h"
+#include <iostream>
+
+RenderTargetPool::RenderTargetPool(int maxIdleFrames)
+    : frameIndex(0), maxIdleFrames(maxIdleFrames), createdThisFrame(0), inUseBytes(0), peakInUseBytes(0) {
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    Clear();
+}
+
+Framebuffer* RenderTargetPool::Acquire(const RenderTargetDesc& desc) {
+    for (Entry& e : entries) {
+        if (!e.InUse && e.Desc == desc) {
+            e.InUse = true;
+            e.LastUsedFrame = frameIndex;
+            TrackAcquire(e.Target);
+            return e.Target;
+        }
+    }
+
+    Entry e;
+    e.Desc = desc;
+    e.Target = new Framebuffer(desc.Width, desc.Height, desc.Samples > 1, desc.Format, desc.Depth, desc.Samples, desc.DepthTexture);
+    e.InUse = true;
+    e.LastUsedFrame = frameIndex;
+    entries.push_back(e);
+    createdThisFrame++;
+    TrackAcquire(e.Target);
+    return e.Target;
+}
+
+void RenderTargetPool::Release(Framebuffer* target) {
+    if (!target) return;
+    for (Entry& e : entries) {
+        if (e.Target == target) {
+            if (e.InUse) inUseBytes -= target->GetMemoryBytes();
+            e.InUse = false;
+            return;
+        }
+    }
+    std::cout << "WARNING::RENDER_TARGET_POOL:: Release of a target not owned by the pool" << std::endl;
+}
+
+void RenderTargetPool::BeginFrame() {
+    frameIndex++;
+    createdThisFrame = 0;
+    peakInUseBytes = inUseBytes;
+}
+
+void RenderTargetPool::TrackAcquire(Framebuffer* target) {
+    inUseBytes += target->GetMemoryBytes();
+    if (inUseBytes > peakInUseBytes) peakInUseBytes = inUseBytes;
+}
+
+void RenderTargetPool::EndFrame() {
+    for (size_t i = 0; i < entries.size();) {
+        Entry& e = entries[i];
+        if (!e.InUse && frameIndex - e.LastUsedFrame > static_cast<unsigned long long>(maxIdleFrames)) {
+            delete e.Target;
+            entries[i] = entries.back();
+            entries.pop_back();
+        } else {
+            i++;
+        }
+    }
+}
+
+void RenderTargetPool::Clear() {
+    for (Entry& e : entries)
+        delete e.Target;
+    entries.clear();
+    inUseBytes = 0;
+}
+
+size_t RenderTargetPool::GetInUseCount() const {
+    size_t n = 0;
+    for (const Entry& e : entries)
+        if (e.InUse) n++;
+    return n;
+}
+
+size_t RenderTargetPool::GetMemoryBytes() const {
+    size_t bytes = 0;
+    for (const Entry& e : entries)
+        bytes += e.Target->GetMemoryBytes();
+    return bytes;
+}
@@ -0,0 +1,113 @@
+#include "RenderThread.h"
+#include "Profiler.h"
+
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+
+RenderFrame::~RenderFrame() {
+    ClearUi();
+}
+
+void RenderFrame::SetUi(const ImDrawData* drawData) {
+    ClearUi();
+    if (!drawData || !drawData->Valid) return;
+    ui = *drawData; // Header fields and the list array; the lists themselves are cloned below
+    for (int i = 0; i < ui.CmdLists.Size; i++)
+        ui.CmdLists[i] = drawData->CmdLists[i]->CloneOutput();
+}
+
+void RenderFrame::Reset() {
+    Scene = false;
+    Click = ClickTiming();
+    Commands.Clear();
+    ClearUi();
+}
+
+void RenderFrame::ClearUi() {
+    for (ImDrawList* list : ui.CmdLists)
+        IM_DELETE(list);
+    ui.Clear();
+}
+
+RenderThread::RenderThread()
+    : window(nullptr), head(0), queued(0), quit(false), lastWaitMs(0.0f), lastExecuteMs(0.0f),
+      lastCommands(0), lastCommandBytes(0) {
+}
+
+RenderThread::~RenderThread() {
+    Stop();
+}
+
+void RenderThread::Start(GLFWwindow* target, ExecuteFn executeFn) {
+    Stop();
+    window = target;
+    execute = executeFn;
+    quit = false;
+    glfwMakeContextCurrent(NULL); // A context is current on one thread at a time
+    thread = std::thread(&RenderThread::ThreadLoop, this);
+}
+
+void RenderThread::Stop() {
+    if (!thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        quit = true;
+    }
+    wake.notify_one();
+    thread.join(); // Runs the queued frames first
+    glfwMakeContextCurrent(window);
+    for (RenderFrame& frame : frames)
+        frame.Reset(); // UI copies go before the ImGui context does
+}
+
+RenderFrame& RenderThread::BeginFrame() {
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> guard(lock);
+    freed.wait(guard, [this]() { return queued < FRAME_SLOTS; });
+    RenderFrame& frame = frames[(head + queued) % FRAME_SLOTS];
+    guard.unlock();
+    lastWaitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    frame.Reset();
+    return frame;
+}
+
+void RenderThread::SubmitFrame() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+void RenderThread::ThreadLoop() {
+    CGTP_PROFILE_THREAD("Render");
+    glfwMakeContextCurrent(window);
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+        wake.wait(guard, [this]() { return queued > 0 || quit; });
+        if (queued == 0) break;
+        RenderFrame& frame = frames[head];
+        guard.unlock();
+        {
+            CGTP_PROFILE_SCOPE("Execute Frame");
+            std::lock_guard<std::mutex> state(stateLock);
+            auto start = std::chrono::steady_clock::now();
+            execute(frame);
+            lastExecuteMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            lastCommands = frame.Commands.GetCommandCount();
+            lastCommandBytes = frame.Commands.GetByteSize();
+        }
+        {
+            // Outside the state lock: the main thread keeps going while this one waits for vsync
+            CGTP_PROFILE_SCOPE("Swap");
+            glfwSwapBuffers(window);
+        }
+        guard.lock();
+        head = (head + 1) % FRAME_SLOTS;
+        queued--;
+        freed.notify_all();
+    }
+    guard.unlock();
+    glfwMakeContextCurrent(NULL);
+}
@@ -9,11 +9,18 @@
 #include <sstream>
 #include <iostream>
 
+#include "ShaderCache.h"
+#include "Profiler.h"
+
 class Shader {
 public:
     unsigned int ID;
 
-    Shader(const char* vertexPath, const char* fragmentPath) {
+    Shader(const char* vertexPath, const char* fragmentPath) : Shader(vertexPath, fragmentPath, std::string()) {}
+
+    // defines: extra lines (e.g. "#define USE_BLOOM\n") inserted after the #version line of both stages
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines) {
+        CGTP_PROFILE_SCOPE("Shader Compile");
         // 1. ļ·лȡ/Ƭɫ
         std::string vertexCode;
         std::string fragmentCode;
@@ -40,34 +47,62 @@ public:
         catch (std::ifstream::failure& e) {
             std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
         }
+        if (!defines.empty()) {
+            vertexCode = injectDefines(vertexCode, defines);
+            fragmentCode = injectDefines(fragmentCode, defines);
+        }
         const char* vShaderCode = vertexCode.c_str();
         const char* fShaderCode = fragmentCode.c_str();
 
-        // 2. ɫ
-        unsigned int vertex, fragment;
+        // 2. Ȳƻ棬
+        ID = glCreateProgram();
+        cacheKey = ShaderCache::Key(vertexCode, fragmentCode);
+        vertex = fragment = 0;
+        pending = false;
+        if (ShaderCache::Load(cacheKey, ID))
+            return;
+
+        // 3. ɫ (ֻύȴ״̬Ƴٵ finish()ɲб)
         // ɫ
         vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vShaderCode, NULL);
         glCompileShader(vertex);
-        checkCompileErrors(vertex, "VERTEX");
         // Ƭɫ
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fShaderCode, NULL);
         glCompileShader(fragment);
-        checkCompileErrors(fragment, "FRAGMENT");
         // ɫ
-        ID = glCreateProgram();
         glAttachShader(ID, vertex);
         glAttachShader(ID, fragment);
+        ShaderCache::Prepare(ID);
         glLinkProgram(ID);
-        checkCompileErrors(ID, "PROGRAM");
+        pending = true;
+    }
+
+    // Non-blocking: true once use() will not wait for the driver
+    bool isReady() const {
+        return !pending || ShaderCache::IsCompileFinished(ID, true);
+    }
+
+    // Collect compile/link results (blocks if the driver is still busy) and store the binary
+    void finish() {
+        if (!pending) return;
+        CGTP_PROFILE_SCOPE("Shader Link Wait");
+        pending = false;
+        bool ok = checkCompileErrors(vertex, "VERTEX");
+        ok = checkCompileErrors(fragment, "FRAGMENT") && ok;
+        ok = checkCompileErrors(ID, "PROGRAM") && ok;
+        if (ok)
+            ShaderCache::Store(cacheKey, ID);
         // ɾɫѾӵǵĳˣѾҪ
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+        vertex = fragment = 0;
     }
 
     // ɫ
     void use() {
+        if (pending) finish();
         glUseProgram(ID);
     }
 
@@ -81,6 +116,9 @@ public:
     void setFloat(const std::string& name, float value) const {
         glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
     }
+    void setVec2(const std::string& name, float x, float y) const {
+        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    }
     void setMat4(const std::string& name, const glm::mat4& mat) const {
         glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
     }
@@ -92,7 +130,21 @@ public:
     }
 
 private:
-    void checkCompileErrors(unsigned int shader, std::string type) {
+    // #version must stay the first line, so defines go right after it
+    static std::string injectDefines(const std::string& code, const std::string& defines) {
+        size_t pos = 0;
+        if (code.compare(0, 8, "#version") == 0) {
+            pos = code.find('\n');
+            pos = (pos == std::string::npos) ? code.size() : pos + 1;
+        }
+        return code.substr(0, pos) + defines + code.substr(pos);
+    }
+
+    unsigned int vertex, fragment; // Kept until finish() reads their status
+    uint64_t cacheKey;
+    bool pending;
+
+    bool checkCompileErrors(unsigned int shader, std::string type) {
         int success;
         char infoLog[1024];
         if (type != "PROGRAM") {
@@ -109,6 +161,7 @@ private:
                 std::cout << "ERROR::PROGRAM_LINKING_ERROR of type: " << type << "\n" << infoLog << "\n -- --------------------------------------------------- -- " << std::endl;
             }
         }
+        return success != 0;
     }
 };
 #endif
\ No newline at end of file
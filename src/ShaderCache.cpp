@@ -0,0 +1,218 @@
+#include "ShaderCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Extension enums/entry points not in the GL 3.3 core glad header
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
+typedef void (APIENTRYP PFNGETPROGRAMBINARY)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNPROGRAMBINARY)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNPROGRAMPARAMETERI)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNMAXSHADERCOMPILERTHREADS)(GLuint count);
+
+static PFNGETPROGRAMBINARY pGetProgramBinary = nullptr;
+static PFNPROGRAMBINARY pProgramBinary = nullptr;
+static PFNPROGRAMPARAMETERI pProgramParameteri = nullptr;
+static PFNMAXSHADERCOMPILERTHREADS pMaxShaderCompilerThreads = nullptr;
+
+bool ShaderCache::programBinarySupported = false;
+bool ShaderCache::parallelCompileSupported = false;
+std::string ShaderCache::cacheDirectory;
+uint64_t ShaderCache::driverHash = 0;
+int ShaderCache::hits = 0;
+int ShaderCache::misses = 0;
+
+// Header of a cache file; the binary follows
+struct CacheFileHeader {
+    char magic[4];   // "CGPB"
+    uint32_t version;
+    uint64_t key;    // Guards against hash-named files being swapped
+    uint32_t binaryFormat;
+    uint32_t length;
+};
+static const uint32_t CACHE_FILE_VERSION = 1;
+
+// 64-bit FNV-1a
+static uint64_t HashBytes(const void* data, size_t size, uint64_t hash = 1469598103934665603ull) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t HashString(const std::string& s, uint64_t hash) {
+    // Length first, so ("ab","c") and ("a","bc") differ
+    uint64_t len = s.size();
+    hash = HashBytes(&len, sizeof(len), hash);
+    return HashBytes(s.data(), s.size(), hash);
+}
+
+static bool HasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (ext && std::strcmp(ext, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+static std::string GLString(GLenum name) {
+    const char* s = reinterpret_cast<const char*>(glGetString(name));
+    return s ? s : "";
+}
+
+void ShaderCache::Init(GLADloadproc loader, const std::string& directory) {
+    cacheDirectory = directory;
+    driverHash = HashString(GLString(GL_VENDOR), 1469598103934665603ull);
+    driverHash = HashString(GLString(GL_RENDERER), driverHash);
+    driverHash = HashString(GLString(GL_VERSION), driverHash);
+
+    GLint majorVersion = 0, minorVersion = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &majorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+    bool core41 = majorVersion > 4 || (majorVersion == 4 && minorVersion >= 1);
+
+    if (core41 || HasExtension("GL_ARB_get_program_binary")) {
+        pGetProgramBinary = (PFNGETPROGRAMBINARY)loader("glGetProgramBinary");
+        pProgramBinary = (PFNPROGRAMBINARY)loader("glProgramBinary");
+        pProgramParameteri = (PFNPROGRAMPARAMETERI)loader("glProgramParameteri");
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        // Some drivers expose the entry points but no formats (nothing to store)
+        programBinarySupported = pGetProgramBinary && pProgramBinary && pProgramParameteri && formats > 0;
+    }
+
+    if (HasExtension("GL_KHR_parallel_shader_compile")) {
+        pMaxShaderCompilerThreads = (PFNMAXSHADERCOMPILERTHREADS)loader("glMaxShaderCompilerThreadsKHR");
+        if (pMaxShaderCompilerThreads) {
+            pMaxShaderCompilerThreads(0xFFFFFFFFu); // Let the driver pick
+            parallelCompileSupported = true;
+        }
+    } else if (HasExtension("GL_ARB_parallel_shader_compile")) {
+        pMaxShaderCompilerThreads = (PFNMAXSHADERCOMPILERTHREADS)loader("glMaxShaderCompilerThreadsARB");
+        if (pMaxShaderCompilerThreads) {
+            pMaxShaderCompilerThreads(0xFFFFFFFFu);
+            parallelCompileSupported = true;
+        }
+    }
+
+    if (programBinarySupported) {
+        std::error_code ec;
+        std::filesystem::create_directories(cacheDirectory, ec);
+        if (ec) {
+            std::cout << "WARNING::SHADER_CACHE:: cannot create " << cacheDirectory << ", caching disabled" << std::endl;
+            programBinarySupported = false;
+        }
+    }
+
+    std::cout << "Shader cache: program binaries " << (programBinarySupported ? "on" : "off")
+              << ", parallel compile " << (parallelCompileSupported ? "on" : "off") << std::endl;
+}
+
+uint64_t ShaderCache::Key(const std::string& vertexCode, const std::string& fragmentCode) {
+    uint64_t hash = HashString(vertexCode, driverHash);
+    return HashString(fragmentCode, hash);
+}
+
+std::string ShaderCache::PathFor(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return cacheDirectory + "/" + name;
+}
+
+bool ShaderCache::Load(uint64_t key, unsigned int program) {
+    if (!programBinarySupported) return false;
+
+    std::ifstream file(PathFor(key), std::ios::binary);
+    if (!file) {
+        misses++;
+        return false;
+    }
+
+    CacheFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, "CGPB", 4) != 0 || header.version != CACHE_FILE_VERSION
+        || header.key != key || header.length == 0) {
+        misses++;
+        return false;
+    }
+    std::vector<char> binary(header.length);
+    file.read(binary.data(), header.length);
+    if (!file) {
+        misses++;
+        return false;
+    }
+
+    pProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    pProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(header.length));
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        // Driver changed in a way the key did not catch; the caller recompiles and overwrites
+        misses++;
+        return false;
+    }
+    hits++;
+    return true;
+}
+
+void ShaderCache::Store(uint64_t key, unsigned int program) {
+    if (!programBinarySupported) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    pGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    CacheFileHeader header;
+    std::memcpy(header.magic, "CGPB", 4);
+    header.version = CACHE_FILE_VERSION;
+    header.key = key;
+    header.binaryFormat = format;
+    header.length = static_cast<uint32_t>(written);
+
+    // Write to a temp file and rename, so a crash never leaves a truncated entry behind
+    std::string path = PathFor(key);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file) return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) std::filesystem::remove(tmpPath, ec);
+}
+
+void ShaderCache::Prepare(unsigned int program) {
+    if (programBinarySupported)
+        pProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+bool ShaderCache::IsCompileFinished(unsigned int object, bool isProgram) {
+    if (!parallelCompileSupported) return true; // Querying status would just block anyway
+    GLint done = 0;
+    if (isProgram) glGetProgramiv(object, GL_COMPLETION_STATUS_KHR, &done);
+    else glGetShaderiv(object, GL_COMPLETION_STATUS_KHR, &done);
+    return done != 0;
+}
@@ -0,0 +1,279 @@
+#include "TargetGrid.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TargetGrid::TargetGrid(float cellSize, float itemRadius)
+    : cellSize(std::max(cellSize, 2.0f * itemRadius)), itemRadius(itemRadius), count(0),
+      boundsMin(std::numeric_limits<int>::max()), boundsMax(std::numeric_limits<int>::min()), queryStamp(0)
+{
+    // A cell must be at least as wide as an item, otherwise one item could span more than 8 cells
+    invCellSize = 1.0f / this->cellSize;
+}
+
+glm::ivec3 TargetGrid::CellOf(const glm::vec3& p) const {
+    return glm::ivec3(glm::floor(p * invCellSize));
+}
+
+uint64_t TargetGrid::Key(int x, int y, int z) {
+    // 21 bits per axis, enough for +-1M cells in every direction
+    return ((uint64_t)(x & 0x1FFFFF) << 42) | ((uint64_t)(y & 0x1FFFFF) << 21) | (uint64_t)(z & 0x1FFFFF);
+}
+
+void TargetGrid::Insert(unsigned int id, const glm::vec3& position) {
+    if (id >= items.size()) {
+        items.resize(id + 1);
+        stamps.resize(id + 1, 0);
+    }
+    if (items[id].alive) {
+        Move(id, position);
+        return;
+    }
+
+    items[id].position = position;
+    items[id].alive = true;
+    Link(id);
+    count++;
+}
+
+void TargetGrid::Remove(unsigned int id) {
+    if (!Contains(id)) return;
+    Unlink(id);
+    items[id].alive = false;
+    count--;
+}
+
+void TargetGrid::Move(unsigned int id, const glm::vec3& position) {
+    if (!Contains(id)) return;
+
+    Item& item = items[id];
+    glm::ivec3 oldMin = CellOf(item.position - glm::vec3(itemRadius));
+    glm::ivec3 oldMax = CellOf(item.position + glm::vec3(itemRadius));
+    glm::ivec3 oldHome = CellOf(item.position);
+    glm::ivec3 newMin = CellOf(position - glm::vec3(itemRadius));
+    glm::ivec3 newMax = CellOf(position + glm::vec3(itemRadius));
+    glm::ivec3 newHome = CellOf(position);
+
+    item.position = position;
+    // Most frames a moving item stays inside the same cells: nothing to relink
+    if (oldMin == newMin && oldMax == newMax && oldHome == newHome)
+        return;
+
+    Unlink(id);
+    Link(id);
+}
+
+void TargetGrid::Clear() {
+    cells.clear();
+    items.clear();
+    stamps.clear();
+    count = 0;
+    boundsMin = glm::ivec3(std::numeric_limits<int>::max());
+    boundsMax = glm::ivec3(std::numeric_limits<int>::min());
+}
+
+bool TargetGrid::Contains(unsigned int id) const {
+    return id < items.size() && items[id].alive;
+}
+
+void TargetGrid::Link(unsigned int id) {
+    Item& item = items[id];
+    glm::ivec3 home = CellOf(item.position);
+    glm::ivec3 lo = CellOf(item.position - glm::vec3(itemRadius));
+    glm::ivec3 hi = CellOf(item.position + glm::vec3(itemRadius));
+
+    // Home cell first so that queries testing centers can skip the other links (sub != 0)
+    item.cellCount = 0;
+    auto addLink = [&](int x, int y, int z) {
+        uint64_t key = Key(x, y, z);
+        std::vector<CellEntry>& bucket = cells[key];
+        int k = item.cellCount++;
+        item.cellKeys[k] = key;
+        item.slots[k] = (unsigned int)bucket.size();
+        bucket.push_back({ id, (unsigned int)k });
+        boundsMin = glm::min(boundsMin, glm::ivec3(x, y, z));
+        boundsMax = glm::max(boundsMax, glm::ivec3(x, y, z));
+    };
+
+    addLink(home.x, home.y, home.z);
+    for (int x = lo.x; x <= hi.x; x++)
+        for (int y = lo.y; y <= hi.y; y++)
+            for (int z = lo.z; z <= hi.z; z++)
+                if (glm::ivec3(x, y, z) != home)
+                    addLink(x, y, z);
+}
+
+void TargetGrid::Unlink(unsigned int id) {
+    Item& item = items[id];
+    for (int k = 0; k < item.cellCount; k++) {
+        auto it = cells.find(item.cellKeys[k]);
+        std::vector<CellEntry>& bucket = it->second;
+        unsigned int slot = item.slots[k];
+
+        // Swap-remove, then patch the back-pointer of the entry that moved
+        CellEntry moved = bucket.back();
+        bucket[slot] = moved;
+        items[moved.id].slots[moved.sub] = slot;
+        bucket.pop_back();
+        if (bucket.empty())
+            cells.erase(it); // Scans only see occupied cells
+    }
+    item.cellCount = 0;
+}
+
+void TargetGrid::RayQuery(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, std::vector<unsigned int>& out) const {
+    out.clear();
+    if (count == 0 || glm::dot(dir, dir) == 0.0f) return;
+
+    glm::vec3 d = glm::normalize(dir);
+
+    if (++queryStamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0u);
+        queryStamp = 1;
+    }
+
+    // Amanatides & Woo grid traversal
+    glm::ivec3 cell = CellOf(origin);
+    glm::ivec3 step(0);
+    glm::vec3 tMax(std::numeric_limits<float>::infinity());
+    glm::vec3 tDelta(std::numeric_limits<float>::infinity());
+    for (int i = 0; i < 3; i++) {
+        if (d[i] > 0.0f) {
+            step[i] = 1;
+            tMax[i] = ((cell[i] + 1) * cellSize - origin[i]) / d[i];
+            tDelta[i] = cellSize / d[i];
+        }
+        else if (d[i] < 0.0f) {
+            step[i] = -1;
+            tMax[i] = (cell[i] * cellSize - origin[i]) / d[i];
+            tDelta[i] = -cellSize / d[i];
+        }
+    }
+
+    float t = 0.0f;
+    while (t <= maxDistance) {
+        auto it = cells.find(Key(cell.x, cell.y, cell.z));
+        if (it != cells.end()) {
+            for (const CellEntry& e : it->second) {
+                if (stamps[e.id] == queryStamp) continue;
+                stamps[e.id] = queryStamp;
+                out.push_back(e.id);
+            }
+        }
+
+        int axis = (tMax.x < tMax.y) ? ((tMax.x < tMax.z) ? 0 : 2) : ((tMax.y < tMax.z) ? 1 : 2);
+        t = tMax[axis];
+        cell[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+    }
+}
+
+void TargetGrid::ConeQuery(const glm::vec3& origin, const glm::vec3& dir, float halfAngleDeg, float maxDistance, std::vector<unsigned int>& out) const {
+    out.clear();
+    if (count == 0 || glm::dot(dir, dir) == 0.0f) return;
+
+    glm::vec3 axis = glm::normalize(dir);
+    float halfAngle = glm::radians(glm::clamp(halfAngleDeg, 0.0f, 180.0f));
+    float cosHalf = std::cos(halfAngle);
+    float sinHalf = std::sin(halfAngle);
+    float cellRadius = cellSize * 0.8660254f; // Half of the cell diagonal
+
+    if (++queryStamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0u);
+        queryStamp = 1;
+    }
+    auto testCell = [&](const std::vector<CellEntry>& bucket) {
+        for (const CellEntry& e : bucket) {
+            if (e.sub != 0 || stamps[e.id] == queryStamp) continue; // Only the home cell holds the center
+            stamps[e.id] = queryStamp;
+            glm::vec3 p = items[e.id].position - origin;
+            float len = glm::length(p);
+            if (len > maxDistance) continue;
+            if (len < 1e-5f || glm::dot(p, axis) >= len * cosHalf)
+                out.push_back(e.id);
+        }
+    };
+
+    // Narrow cone: slice it along the axis, one cell deep. The slice between axial distances d0
+    // and d1 lies inside the hull of two disks of its far radius (capped at maxDistance * sin),
+    // whose box is cheap. Boxes are clipped to the occupied bounds; adjacent ones overlap, the
+    // stamps drop the repeats. Used while the boxes hold fewer cells than the map.
+    if (halfAngle < glm::half_pi<float>()) {
+        const float tanHalf = sinHalf / cosHalf;
+        const glm::vec3 spread = glm::sqrt(glm::max(glm::vec3(1.0f) - axis * axis, glm::vec3(0.0f)));
+        size_t visits = 0;
+        bool walk = true;
+        sliceBoxes.clear();
+        for (float d0 = 0.0f; d0 < maxDistance && walk; d0 += cellSize) {
+            float d1 = std::min(d0 + cellSize, maxDistance);
+            glm::vec3 extent = std::min(d1 * tanHalf, maxDistance * sinHalf) * spread;
+            glm::vec3 a = origin + axis * d0;
+            glm::vec3 b = origin + axis * d1;
+            glm::ivec3 lo = glm::max(CellOf(glm::min(a, b) - extent), boundsMin);
+            glm::ivec3 hi = glm::min(CellOf(glm::max(a, b) + extent), boundsMax);
+            if (glm::any(glm::lessThan(hi, lo))) continue;
+            glm::ivec3 size = hi - lo + 1;
+            visits += (size_t)size.x * size.y * size.z;
+            walk = visits <= cells.size();
+            sliceBoxes.push_back({ lo, hi });
+        }
+        if (walk) {
+            for (const auto& box : sliceBoxes)
+                for (int x = box.first.x; x <= box.second.x; x++)
+                    for (int y = box.first.y; y <= box.second.y; y++)
+                        for (int z = box.first.z; z <= box.second.z; z++) {
+                            auto it = cells.find(Key(x, y, z));
+                            if (it != cells.end())
+                                testCell(it->second);
+                        }
+            return;
+        }
+    }
+
+    // Wide cone: every occupied cell, rejected as a whole first
+    for (const auto& kv : cells) {
+        const std::vector<CellEntry>& bucket = kv.second;
+
+        // Decode the cell coordinates back from the key (sign-extend 21 bits)
+        int c[3];
+        for (int i = 0; i < 3; i++) {
+            int v = (int)((kv.first >> (42 - 21 * i)) & 0x1FFFFF);
+            c[i] = (v & 0x100000) ? v - 0x200000 : v;
+        }
+        glm::vec3 center = (glm::vec3(c[0], c[1], c[2]) + 0.5f) * cellSize;
+
+        // Conservative cell rejection: sphere around the cell vs. distance and cone
+        glm::vec3 v = center - origin;
+        float dist = glm::length(v);
+        if (dist - cellRadius > maxDistance) continue;
+        if (dist > cellRadius && halfAngle < glm::half_pi<float>() && sinHalf > 0.0f) {
+            // Push the apex back so the cone grows by cellRadius, then test the center against it
+            glm::vec3 w = center - (origin - axis * (cellRadius / sinHalf));
+            if (glm::dot(w, axis) < glm::length(w) * cosHalf) continue;
+        }
+        testCell(bucket);
+    }
+}
+
+void TargetGrid::SphereQuery(const glm::vec3& center, float radius, std::vector<unsigned int>& out) const {
+    out.clear();
+    if (count == 0) return;
+
+    glm::ivec3 lo = CellOf(center - glm::vec3(radius));
+    glm::ivec3 hi = CellOf(center + glm::vec3(radius));
+    float r2 = radius * radius;
+
+    for (int x = lo.x; x <= hi.x; x++)
+        for (int y = lo.y; y <= hi.y; y++)
+            for (int z = lo.z; z <= hi.z; z++) {
+                auto it = cells.find(Key(x, y, z));
+                if (it == cells.end()) continue;
+                for (const CellEntry& e : it->second) {
+                    if (e.sub != 0) continue;
+                    glm::vec3 d = items[e.id].position - center;
+                    if (glm::dot(d, d) <= r2)
+                        out.push_back(e.id);
+                }
+            }
+}
@@ -0,0 +1,199 @@
+#include "TargetPool.h"
+#include <cmath>
+
+TargetHandle TargetPool::Create(const glm::vec3& position, const glm::vec3& velocity) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slotToDense.size());
+        slotToDense.push_back(0);
+        generations.push_back(0);
+    }
+
+    slotToDense[slot] = static_cast<uint32_t>(denseToSlot.size());
+    denseToSlot.push_back(slot);
+
+    PosX.push_back(position.x);
+    PosY.push_back(position.y);
+    PosZ.push_back(position.z);
+    VelX.push_back(velocity.x);
+    VelY.push_back(velocity.y);
+    VelZ.push_back(velocity.z);
+    PrevX.push_back(position.x);
+    PrevY.push_back(position.y);
+    PrevZ.push_back(position.z);
+    ActiveTime.push_back(0.0f);
+    IsActive.push_back(1);
+
+    TargetHandle h;
+    h.slot = slot;
+    h.generation = generations[slot];
+    return h;
+}
+
+bool TargetPool::Destroy(TargetHandle handle) {
+    if (!IsValid(handle)) return false;
+
+    uint32_t dense = slotToDense[handle.slot];
+    uint32_t last = static_cast<uint32_t>(denseToSlot.size() - 1);
+
+    // Swap-remove: move the last element into the hole, keep columns packed
+    if (dense != last) {
+        PosX[dense] = PosX[last];
+        PosY[dense] = PosY[last];
+        PosZ[dense] = PosZ[last];
+        VelX[dense] = VelX[last];
+        VelY[dense] = VelY[last];
+        VelZ[dense] = VelZ[last];
+        PrevX[dense] = PrevX[last];
+        PrevY[dense] = PrevY[last];
+        PrevZ[dense] = PrevZ[last];
+        ActiveTime[dense] = ActiveTime[last];
+        IsActive[dense] = IsActive[last];
+
+        uint32_t movedSlot = denseToSlot[last];
+        denseToSlot[dense] = movedSlot;
+        slotToDense[movedSlot] = dense;
+    }
+
+    PosX.pop_back();
+    PosY.pop_back();
+    PosZ.pop_back();
+    VelX.pop_back();
+    VelY.pop_back();
+    VelZ.pop_back();
+    PrevX.pop_back();
+    PrevY.pop_back();
+    PrevZ.pop_back();
+    ActiveTime.pop_back();
+    IsActive.pop_back();
+    denseToSlot.pop_back();
+
+    generations[handle.slot]++;
+    freeSlots.push_back(handle.slot);
+    return true;
+}
+
+void TargetPool::Clear() {
+    // Invalidate every outstanding handle, keep the slots for reuse
+    for (uint32_t slot : denseToSlot) {
+        generations[slot]++;
+        freeSlots.push_back(slot);
+    }
+    PosX.clear();
+    PosY.clear();
+    PosZ.clear();
+    VelX.clear();
+    VelY.clear();
+    VelZ.clear();
+    PrevX.clear();
+    PrevY.clear();
+    PrevZ.clear();
+    ActiveTime.clear();
+    IsActive.clear();
+    denseToSlot.clear();
+}
+
+void TargetPool::Reserve(size_t capacity) {
+    PosX.reserve(capacity);
+    PosY.reserve(capacity);
+    PosZ.reserve(capacity);
+    VelX.reserve(capacity);
+    VelY.reserve(capacity);
+    VelZ.reserve(capacity);
+    PrevX.reserve(capacity);
+    PrevY.reserve(capacity);
+    PrevZ.reserve(capacity);
+    ActiveTime.reserve(capacity);
+    IsActive.reserve(capacity);
+    denseToSlot.reserve(capacity);
+    slotToDense.reserve(capacity);
+    generations.reserve(capacity);
+}
+
+bool TargetPool::IsValid(TargetHandle handle) const {
+    return handle.slot < generations.size() && generations[handle.slot] == handle.generation
+        && slotToDense[handle.slot] < denseToSlot.size() && denseToSlot[slotToDense[handle.slot]] == handle.slot;
+}
+
+TargetHandle TargetPool::HandleAt(size_t denseIndex) const {
+    TargetHandle h;
+    h.slot = denseToSlot[denseIndex];
+    h.generation = generations[h.slot];
+    return h;
+}
+
+void TargetPool::Age(float deltaTime) {
+    const size_t n = ActiveTime.size();
+    float* t = ActiveTime.data();
+    for (size_t i = 0; i < n; i++)
+        t[i] += deltaTime;
+}
+
+int TargetPool::RayScan(const glm::vec3& origin, const glm::vec3& dir, float radius, float maxDistance, float* outDistance) const {
+    const size_t n = PosX.size();
+    const float* px = PosX.data();
+    const float* py = PosY.data();
+    const float* pz = PosZ.data();
+    const uint8_t* active = IsActive.data();
+
+    glm::vec3 d = glm::normalize(dir);
+    const float r2 = radius * radius;
+
+    // Blocked two-pass loop: the first pass is branch-free and vectorizes (masked squared
+    // distance per target); only blocks that contain a hit get the scalar nearest search
+    const int BLOCK = 256;
+    float masked[BLOCK];
+    int best = -1;
+    float bestDist2 = maxDistance * maxDistance;
+    for (size_t base = 0; base < n; base += BLOCK) {
+        const int m = static_cast<int>(n - base < BLOCK ? n - base : BLOCK);
+        int anyHit = 0;
+        for (int j = 0; j < m; j++) {
+            const size_t i = base + j;
+            float vx = px[i] - origin.x;
+            float vy = py[i] - origin.y;
+            float vz = pz[i] - origin.z;
+            float tc = vx * d.x + vy * d.y + vz * d.z;
+            float len2 = vx * vx + vy * vy + vz * vz;
+            float perp2 = len2 - tc * tc;
+            bool hit = (active[i] != 0) & (tc > 0.0f) & (perp2 < r2);
+            masked[j] = hit ? len2 : INFINITY;
+            anyHit |= static_cast<int>(hit);
+        }
+        if (!anyHit) continue;
+        for (int j = 0; j < m; j++) {
+            if (masked[j] < bestDist2) {
+                bestDist2 = masked[j];
+                best = static_cast<int>(base + j);
+            }
+        }
+    }
+
+    if (outDistance && best >= 0) *outDistance = std::sqrt(bestDist2);
+    return best;
+}
+
+void TargetPool::SavePrevious() {
+    PrevX = PosX;
+    PrevY = PosY;
+    PrevZ = PosZ;
+}
+
+size_t TargetPool::FillInstanceOffsets(float* out, float alpha) const {
+    const size_t n = PosX.size();
+    const float* px = PosX.data();
+    const float* py = PosY.data();
+    const float* pz = PosZ.data();
+    const float* qx = PrevX.data();
+    const float* qy = PrevY.data();
+    const float* qz = PrevZ.data();
+    for (size_t i = 0; i < n; i++) {
+        out[i * 3 + 0] = qx[i] + (px[i] - qx[i]) * alpha;
+        out[i * 3 + 1] = qy[i] + (py[i] - qy[i]) * alpha;
+        out[i * 3 + 2] = qz[i] + (pz[i] - qz[i]) * alpha;
+    }
+    return n;
+}
@@ -10,14 +10,56 @@
 #include "Model.h"
 #include "PostProcessor.h"
 #include "GameManager.h" // Include Game Logic
+#include "TargetRenderer.h"
+#include "FixedTimestep.h"
+#include "JobSystem.h"
+#include "FramePipeline.h"
+#include "RenderCommands.h"
+#include "RenderThread.h"
+#include "FrameLimiter.h"
+#include "LookLatch.h"
+#include "LatencyLog.h"
+#include "ShaderCache.h"
+#include "GpuProfiler.h"
+#include "Profiler.h"
+#include "FrameStats.h"
+#include "HeadlessContext.h"
+#include "PngWriter.h"
+#include "CameraPath.h"
+#include "BenchmarkReport.h"
+#include "Frustum.h"
+#include "RenderStats.h"
+#include "InputState.h"
+#include "InputRecorder.h"
 
 #include <filesystem> // 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
 
 // ---  ---
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);  
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset); 
-void processInput(GLFWwindow* window);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+void applyInput(const InputEvent& e);
+void pollInput();
+void processInput(RenderPacket& packet);
+void stepPlayer(float dt);
+void drawHud(const RenderPacket& packet);
+void drawDebugPanel();
+struct HeadlessOptions;
+// [Modified] Scene pass: records a packet with the given (unjittered) projection and view
+typedef std::function<void(const RenderPacket&, const glm::mat4&, const glm::mat4&, RenderCommandBuffer&)> SceneDrawFn;
+// [New] Culling and target offsets of a packet (Eye and Alpha set), for an aspect ratio;
+// [Modified] cullMargin widens the culled field of view (degrees)
+typedef std::function<void(RenderPacket&, float, float)> ScenePrepareFn;
+int runHeadless(const HeadlessOptions& options, const ScenePrepareFn& prepareScene, const SceneDrawFn& drawScene);
 
 const unsigned int SCR_WIDTH = 1280;
 const unsigned int SCR_HEIGHT = 720;
@@ -31,57 +73,222 @@ bool firstMouse = true;
 
 // ʱ (ͬٶȲһ)
 float deltaTime = 0.0f;
-float lastFrame = 0.0f;
+double lastFrame = 0.0; // [Modified] double: a float clock loses precision after a few hours
+FixedTimestep simulationClock; // [New] The game advances in fixed steps; rendering interpolates between the last two
+glm::vec3 previousCameraPosition = camera.Position; // [New] Camera position before the last step
 bool isCursorVisible = false; // Cursor state toggle
+bool showDebugPanel = false; // [New] F1 toggles the debug panel
+bool frustumCulling = true; // [New] Per-mesh frustum culling of the city
 
 GameManager gameManager; // Game Manager Instance
+TargetRenderer targetRenderer; // [New] GL side of the targets (GameManager is simulation only)
+FrameStats frameStats; // [New] Frame time percentiles + hitch capture
+FramePipeline framePipeline; // [New] Game thread builds frame N+1 while this thread submits frame N
+RenderThread renderThread; // [New] --render-thread: owns the GL context, executes the frames this thread records
+std::mutex gpuFrameLock; // [New] GPU frame times measured on the render thread, for frameStats
+std::vector<float> gpuFrameTimes;
+FrameLimiter frameLimiter; // [New] Fences cap the frames queued on the GPU; used by the thread that submits
+LookLatch lookLatch; // [New] Camera orientation taken again right before the frame is submitted
+LatencyLog latencyLog; // [New] --latency-log FILE: click -> GPU done for every CheckShot; thread that submits
+
+// [New] Input goes GLFW callback -> (recorder) -> pendingInput -> applyInput; a replay feeds the log into pendingInput
+InputState input;
+InputRecorder inputRecorder;
+std::vector<InputEvent> replayEvents; // This frame's replayed events, queued in pollInput
+std::vector<InputEvent> pendingInput; // [New] Polled, not yet applied (the menu applies them at once, else the game thread)
+std::chrono::steady_clock::time_point pendingClickTime; // [New] First left press in pendingInput (epoch = none)
+
+float startupMs = 0.0f; // [New] main() until the first frame (context, shaders, model, textures)
+
+// [New] Headless benchmark: no window, no menus, fixed time step, timings (+ optional PNGs) to OutDir
+// CGTeamProject --headless [--frames N] [--warmup N] [--size WxH] [--png-every N] [--out DIR] [--dynres]
+// CGTeamProject --benchmark assets/paths/city_flythrough.path [...]: headless along a scripted camera
+// path; the path sets the frame count (unless --frames) and benchmark.json gets per-segment results
+// Scene setup for either: [--aa off|msaa2|msaa4|msaa8|fxaa|smaa|taa|taau] [--drones N]
+struct HeadlessOptions {
+    bool Enabled = false;
+    int Frames = 0;                // 0 = the path's frame count, or 600 without a path
+    int Warmup = 60;               // Rendered but not recorded (shader variants, pool, caches)
+    int Width = SCR_WIDTH;
+    int Height = SCR_HEIGHT;
+    int PngEvery = 0;              // Dump every Nth recorded frame, 0 = none (dumps stall the pipeline)
+    bool DynamicResolution = false; // Off by default: every frame renders the same pixel count
+    std::string OutDir = "headless_out";
+    std::string PathFile;          // Camera path (--benchmark), empty = slow pan
+    int AAMode = -1;               // AA_Mode, -1 = keep the default
+    int Drones = 0;                // > 0: drone mode with this many drones
+};
+
+// Command line spelling of AA_Mode, in enum order
+static const char* AA_MODE_OPTION[AA_MODE_COUNT] = { "off", "msaa2", "msaa4", "msaa8", "fxaa", "smaa", "taa", "taau" };
+
+// [New] CGTeamProject --record FILE: log all input of the session; --replay FILE: play it back
+// (same seed, same per-frame delta times) and exit when the log ends
+// [New] CGTeamProject --render-thread: all GL calls of the game loop on a dedicated render thread
+// [New] --frames-in-flight N: frames the GPU may fall behind (0 = no cap); --latency-log FILE: click latency CSV
+static bool parseCommandLine(int argc, char** argv, HeadlessOptions& options, std::string& recordPath, std::string& replayPath,
+                             bool& renderThreaded, int& framesInFlight, std::string& latencyPath) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.Enabled = true;
+        } else if (std::strcmp(arg, "--benchmark") == 0 && value) {
+            options.Enabled = true;
+            options.PathFile = value; i++;
+        } else if (std::strcmp(arg, "--record") == 0 && value) {
+            recordPath = value; i++;
+        } else if (std::strcmp(arg, "--replay") == 0 && value) {
+            replayPath = value; i++;
+        } else if (std::strcmp(arg, "--render-thread") == 0) {
+            renderThreaded = true;
+        } else if (std::strcmp(arg, "--frames-in-flight") == 0 && value) {
+            framesInFlight = std::max(0, std::atoi(value)); i++;
+            if (framesInFlight > FrameLimiter::MAX_FRAMES_IN_FLIGHT)
+                framesInFlight = FrameLimiter::MAX_FRAMES_IN_FLIGHT;
+        } else if (std::strcmp(arg, "--latency-log") == 0 && value) {
+            latencyPath = value; i++;
+        } else if (std::strcmp(arg, "--aa") == 0 && value) {
+            for (int m = 0; m < AA_MODE_COUNT; m++)
+                if (std::strcmp(value, AA_MODE_OPTION[m]) == 0) options.AAMode = m;
+            if (options.AAMode < 0) {
+                std::cout << "Unknown AA mode: " << value << std::endl;
+                return false;
+            }
+            i++;
+        } else if (std::strcmp(arg, "--drones") == 0 && value) {
+            options.Drones = std::max(0, std::atoi(value)); i++;
+        } else if (std::strcmp(arg, "--dynres") == 0) {
+            options.DynamicResolution = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && value) {
+            options.Frames = std::max(1, std::atoi(value)); i++;
+        } else if (std::strcmp(arg, "--warmup") == 0 && value) {
+            options.Warmup = std::max(0, std::atoi(value)); i++;
+        } else if (std::strcmp(arg, "--png-every") == 0 && value) {
+            options.PngEvery = std::max(0, std::atoi(value)); i++;
+        } else if (std::strcmp(arg, "--out") == 0 && value) {
+            options.OutDir = value; i++;
+        } else if (std::strcmp(arg, "--size") == 0 && value && std::sscanf(value, "%dx%d", &options.Width, &options.Height) == 2
+                   && options.Width > 0 && options.Height > 0) {
+            i++;
+        } else {
+            std::cout << "Unknown argument: " << arg << std::endl
+                      << "Usage: " << argv[0] << " [--record FILE | --replay FILE] [--render-thread] [--frames-in-flight N] [--latency-log FILE]" << std::endl
+                      << "       " << argv[0] << " [--headless | --benchmark PATH] [--frames N] [--warmup N] [--size WxH] [--png-every N] [--out DIR] [--dynres] [--aa MODE] [--drones N]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
 
-int main()
+int main(int argc, char** argv)
 {
-    std::cout << "Current path is: " << std::filesystem::current_path() << std::endl; // 
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Cyberpunk Recon", NULL, NULL);
-    if (window == NULL) {
-        std::cout << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
+    auto startTime = std::chrono::steady_clock::now();
+    HeadlessOptions headless;
+    std::string recordPath, replayPath;
+    bool renderThreaded = false;
+    std::string latencyPath;
+    if (!parseCommandLine(argc, argv, headless, recordPath, replayPath, renderThreaded, frameLimiter.MaxFramesInFlight, latencyPath))
         return -1;
+    JobSystem::Init(); // [New] Worker threads for loading, culling and the drone kernel
+
+    std::cout << "Current path is: " << std::filesystem::current_path() << std::endl; // 
+
+    // [New] Headless: offscreen EGL context; without EGL fall back to a hidden window
+    HeadlessContext headlessContext;
+    GLFWwindow* window = NULL;
+    GLADloadproc glLoader = (GLADloadproc)glfwGetProcAddress;
+    std::string headlessError;
+    if (headless.Enabled && headlessContext.Create(headlessError)) {
+        std::cout << "Headless: EGL " << headlessContext.GetPlatformName() << " context" << std::endl;
+        glLoader = (GLADloadproc)HeadlessContext::GetProcAddress;
+    } else {
+        if (headless.Enabled)
+            std::cout << "Headless: " << headlessError << ", using a hidden window" << std::endl;
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        if (headless.Enabled)
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Cyberpunk Recon", NULL, NULL);
+        if (window == NULL) {
+            std::cout << "Failed to create GLFW window" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+        glfwMakeContextCurrent(window);
+        if (headless.Enabled)
+            glfwSwapInterval(0);
     }
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    // עص
-    glfwSetCursorPosCallback(window, mouse_callback);
-    glfwSetScrollCallback(window, scroll_callback);
+    if (!headless.Enabled) {
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    //  ع겢׽
-    //  ע⣺ ESC ˳ǰܿ꣬
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-    if (glfwRawMouseMotionSupported())
-        glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE); // Optional improved aiming
+        // עص
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+        glfwSetKeyCallback(window, key_callback);
+        glfwSetMouseButtonCallback(window, mouse_button_callback);
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        //  ع겢׽
+        //  ע⣺ ESC ˳ǰܿ꣬
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+        if (glfwRawMouseMotionSupported())
+            glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE); // Optional improved aiming
+    }
+
+    if (!gladLoadGLLoader(glLoader)) {
         std::cout << "Failed to initialize GLAD" << std::endl;
         return -1;
     }
 
+    // Program binary cache + parallel compile; must come before the first Shader is created
+    ShaderCache::Init(glLoader);
+
     // Initialize PostProcessor
-    postProcessor = new PostProcessor(SCR_WIDTH, SCR_HEIGHT);
-    // [Modified] Enable Glitch by default, Disable Bloom by default
+    if (headless.Enabled)
+        postProcessor = new PostProcessor(headless.Width, headless.Height);
+    else
+        postProcessor = new PostProcessor(SCR_WIDTH, SCR_HEIGHT);
+    // [Modified] Enable Glitch and Bloom by default (mip-chain bloom is cheap enough to leave on)
     postProcessor->UseGlitch = true;
-    postProcessor->UseBloom = false;
+    postProcessor->UseBloom = true;
+    postProcessor->PrecompileVariant(postProcessor->GetFeatureMask());
 
     // Initialize Game
-    gameManager.Init();
-
-    // ImGui ʼ
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init("#version 330");
+    // [New] Input recording / replay: the log carries the spawn seed
+    std::string inputError;
+    if (!recordPath.empty() && !inputRecorder.StartRecording(recordPath, gameManager.GetSeed(), inputError))
+        std::cout << "ERROR::INPUT:: " << inputError << std::endl;
+    if (!replayPath.empty()) {
+        if (!inputRecorder.StartReplay(replayPath, inputError)) {
+            std::cout << "ERROR::INPUT:: " << inputError << std::endl;
+            return -1;
+        }
+        gameManager.SetSeed(inputRecorder.GetSeed());
+        std::cout << "Input: replaying " << inputRecorder.GetFrameCount() << " frames from " << replayPath << std::endl;
+    }
+    // [New] Click-to-photon log
+    if (!latencyPath.empty()) {
+        if (latencyLog.Open(latencyPath, inputError))
+            std::cout << "Latency: logging clicks to " << latencyPath << std::endl;
+        else
+            std::cout << "ERROR::LATENCY:: " << inputError << std::endl;
+    }
+    if (inputRecorder.GetMode() != InputRecorder::OFF)
+        gameManager.GetDroneSwarm().BudgetMs = 1e9f; // Step every drone: the adaptive window follows wall time
+    gameManager.StartGame();
+    targetRenderer.Init();
+
+    // ImGui ʼ (not in headless mode: nothing to show it on)
+    if (!headless.Enabled) {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+        ImGui_ImplGlfw_InitForOpenGL(window, true);
+        ImGui_ImplOpenGL3_Init("#version 330");
+    }
 
     // --- ģɫ ---
 
@@ -91,21 +298,31 @@ int main()
 
     // 2. ɫ (ע·)
     // · "shaders/textured.vs"
+    CGTP_PROFILE_THREAD("Main");
     Shader ourShader("shaders/textured.vs", "shaders/textured.fs");
 
+    // [New] Decode the City_Bake_4K.png bake on a job while Assimp imports the city on this thread
+    string textName = "City_Bake_4K.png";
+    string textPath = "assets/" + textName;
+    int width = 0, height = 0, nrChannels = 0;
+    unsigned char* data = nullptr;
+    const char* decodeError = nullptr; // stb keeps the failure reason per thread
+    stbi_set_flip_vertically_on_load(false); // [Check] Bake textures usually don't need flip if UVs match standard GLTF
+    JobSystem::Counter bakeDecoded;
+    JobSystem::Run([&]() {
+        CGTP_PROFILE_SCOPE("Texture Decode");
+        data = stbi_load(textPath.c_str(), &width, &height, &nrChannels, 0);
+        if (!data) decodeError = stbi_failure_reason();
+    }, &bakeDecoded);
+
     // 3. ģ (ӡ Assimp ־)
     // ע⣺·ָ assets  .gltf ļ
     Model ourModel("assets/CuberpunkCityWithKaws.glb");
+    JobSystem::Wait(bakeDecoded);
 
     // [New] Manually load and assign City_Bake_4K.png texture
     // This ensures the model uses the provided texture even if the GLB doesn't reference it correctly.
     {
-        string textName = "City_Bake_4K.png";
-        string textPath = "assets/" + textName;
-        int width, height, nrChannels;
-        stbi_set_flip_vertically_on_load(false); // [Check] Bake textures usually don't need flip if UVs match standard GLTF
-        unsigned char* data = stbi_load(textPath.c_str(), &width, &height, &nrChannels, 0);
-        
         if (data) {
             std::cout << "Loaded texture: " << textName << " (" << width << "x" << height << ")" << std::endl;
             unsigned int cityTextureID;
@@ -134,7 +351,7 @@ int main()
                 mesh.textures.push_back(t);
             }
         } else {
-            std::cout << "Failed to load texture: " << textPath << " (Reason: " << stbi_failure_reason() << ")" << std::endl;
+            std::cout << "Failed to load texture: " << textPath << " (Reason: " << (decodeError ? decodeError : "unknown") << ")" << std::endl;
             // Fallback: Create a MAGENTA texture to indicate error visibly
             unsigned int errorTexture;
             glGenTextures(1, &errorTexture);
@@ -167,7 +384,11 @@ int main()
         string textPath = "assets/StartPage.jpg";
         int nrChannels;
         stbi_set_flip_vertically_on_load(false); 
-        unsigned char* data = stbi_load(textPath.c_str(), &startPageWidth, &startPageHeight, &nrChannels, 0);
+        unsigned char* data;
+        {
+            CGTP_PROFILE_SCOPE("Texture Decode");
+            data = stbi_load(textPath.c_str(), &startPageWidth, &startPageHeight, &nrChannels, 0);
+        }
         if (data) {
              glGenTextures(1, &startPageTexture);
              glBindTexture(GL_TEXTURE_2D, startPageTexture);
@@ -191,9 +412,140 @@ int main()
         }
     }
 
+    // ģ; (ÿ֡䣬ѭһ)
+    glm::mat4 cityModel = glm::mat4(1.0f);
+
+    //  -5 (վڵ)Զ -10 (ȷҰ)
+    cityModel = glm::translate(cityModel, glm::vec3(0.0f, -5.0f, -10.0f));
+
+    // [FIX] ̬ Assimp ȡ GLTF ʱܱ Z-UpģͿŵ
+    //  X ת -90 ȣ Z  Y 
+    cityModel = glm::rotate(cityModel, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+    
+    // [FIX] ģǷ(米)ͨҪ Y ת 180 
+    cityModel = glm::rotate(cityModel, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    // 
+    cityModel = glm::scale(cityModel, glm::vec3(10.0f));
+
+    // [New] Building bounds for drone avoidance: per-mesh AABBs in world space
+    {
+        std::vector<AABB> buildings;
+        for (const auto& mesh : ourModel.meshes) {
+            if (!mesh.Bounds.IsValid()) continue;
+            AABB world = mesh.Bounds.Transformed(cityModel);
+            // Skip ground / terrain pieces that cover the whole district
+            if (world.Extent().x > 60.0f || world.Extent().z > 60.0f) continue;
+            buildings.push_back(world);
+        }
+        gameManager.SetObstacles(buildings);
+        std::cout << "Drone obstacles: " << buildings.size() << " building bounds." << std::endl;
+    }
+
     // ùշ ()
     glm::vec3 lightDirection(-0.2f, -1.0f, -0.3f);
 
+    // [New] CPU side of the scene for a packet: frustum culling of the city and the target offsets.
+    // Runs on the game thread (or inline in the headless benchmark); no GL calls
+    auto prepareScene = [&](RenderPacket& packet, float aspect, float cullMargin) {
+        CGTP_PROFILE_SCOPE("Prepare Scene");
+        packet.Culled = frustumCulling;
+        if (frustumCulling) {
+            // [Modified] Wider by cullMargin: a late-latched view may still turn a little
+            Camera cullEye = packet.Eye;
+            cullEye.Zoom += cullMargin;
+            glm::mat4 viewProjection = cullEye.GetProjectionMatrix(aspect, 0.1f, 1000.0f, false) * cullEye.GetViewMatrix();
+            ourModel.Cull(Frustum(viewProjection), cityModel, packet.VisibleMeshes);
+        }
+        const TargetPool& targets = gameManager.GetTargets();
+        packet.TargetOffsets.resize(targets.Size() * 3);
+        packet.TargetOffsets.resize(targets.FillInstanceOffsets(packet.TargetOffsets.data(), packet.Alpha) * 3);
+    };
+
+    // 3D  (scene pass of the frame graph; shared by the game loop and the headless benchmark)
+    // [Modified] Reads only the packet: the game thread may already be changing the game state.
+    // Recorded into cmd: executed at once (immediate buffer) or later on the render thread
+    auto drawScene = [&](const RenderPacket& packet, const glm::mat4& projection, const glm::mat4& view, RenderCommandBuffer& cmd) {
+        CGTP_PROFILE_SCOPE("Submit Scene");
+        // 2.  Shader
+        cmd.UseShader(ourShader);
+    
+        // [NEW] ݹ Uniforms
+        cmd.SetVec3(ourShader, "viewPos", packet.Eye.Position);
+        cmd.SetVec3(ourShader, "lightDirection", lightDirection);
+        cmd.SetFloat(ourShader, "time", packet.Time); // [Added] Pass time
+        cmd.SetInt(ourShader, "objectType", 0); // [Added] Default to City Rendering
+
+        cmd.SetProjection(ourShader, "projection", projection); // TAA jitter is added when it executes
+        cmd.SetMat4(ourShader, "view", view);
+
+        // 4. ģ (Model)
+        cmd.SetMat4(ourShader, "model", cityModel);
+
+        // 5. 
+        // [Fix] ڻǰ󶨰ɫһ TU0
+        // ģе(texture_diffuse)Mesh::Draw ĴḲǰ
+        // ģûвʣShader ͻɫһ֡Ļ˸
+        cmd.ActiveTexture(0);
+        cmd.BindTexture(whiteTexture);
+
+        if (packet.Culled)
+            ourModel.Draw(ourShader, packet.VisibleMeshes, cmd);
+        else
+            ourModel.Draw(ourShader, cmd);
+
+        // [Added] Render Targets (Red Dots)
+        // Reset Model Matrix for Targets
+        targetRenderer.Render(ourShader, packet.TargetOffsets.data(), packet.TargetOffsets.size() / 3, cmd);
+        // --- 3D Ⱦ ---
+    };
+
+    // [New] Game thread side of a frame (see FramePipeline): input, fixed steps, gameplay input,
+    // then a snapshot of everything the GL thread needs to draw it
+    auto buildFrame = [&](const FrameInput& frameInput, RenderPacket& packet) {
+        for (const InputEvent& e : frameInput.Events)
+            applyInput(e);
+
+        // [Modified] Update Game Logic: whole fixed steps, however long the frame was
+        {
+            CGTP_PROFILE_SCOPE("Update");
+            packet.Steps = simulationClock.Advance(frameInput.DeltaTime);
+            gameManager.BeginFrame(packet.Steps); // The steps share the swarm's budget
+            for (int i = 0; i < packet.Steps; i++) {
+                const float step = static_cast<float>(simulationClock.Step);
+                previousCameraPosition = camera.Position;
+                stepPlayer(step);
+                gameManager.Update(step);
+            }
+        }
+
+        {
+            CGTP_PROFILE_SCOPE("Input");
+            packet.Click = ClickTiming();
+            processInput(packet);
+            // [New] Latency log: the press behind this frame's shot
+            if (packet.Click.Valid && frameInput.ClickTime != std::chrono::steady_clock::time_point())
+                packet.Click.Input = frameInput.ClickTime;
+            else
+                packet.Click.Valid = false;
+        }
+
+        // Rendered between the last two steps; mouse look is applied as it arrives
+        packet.Alpha = simulationClock.GetAlpha();
+        packet.Eye = camera;
+        packet.Eye.Position = glm::mix(previousCameraPosition, camera.Position, packet.Alpha);
+        packet.LookTotal = frameInput.LookTotal;
+        packet.Time = static_cast<float>(frameInput.Time);
+        prepareScene(packet, (float)SCR_WIDTH / (float)SCR_HEIGHT, lookLatch.Enabled ? LookLatch::CULL_MARGIN_DEGREES : 0.0f);
+
+        packet.GameOver = gameManager.IsGameOver();
+        packet.Score = gameManager.GetScore();
+        packet.TimeLeft = gameManager.GetTimeLeft();
+        // [New] Visual lock: anomalies inside the current field of view (cone query on the target grid)
+        packet.SignalsInView = packet.GameOver ? 0 : gameManager.GetTargetsInView(camera, camera.Zoom * 0.5f);
+        packet.TargetLocked = !packet.GameOver && gameManager.GetTargetsInView(camera, 1.5f) > 0;
+    };
+
     // [Modified] Game State Machine
     // 0: Start Screen
     // 1: Story/Background
@@ -202,16 +554,107 @@ int main()
     int gameState = 0; 
     bool enterPressed = false; // Debounce for Enter key
 
+    // Loading is done: keep its profile before the frame scopes push it out of the ring
+    startupMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Startup: " << startupMs << " ms" << std::endl;
+    if (Profiler::CompiledIn)
+        Profiler::SaveCapture("cpu_startup.json");
+
+    if (headless.Enabled) {
+        int result = runHeadless(headless, prepareScene, drawScene);
+        JobSystem::Shutdown();
+        delete postProcessor;
+        if (window)
+            glfwTerminate();
+        return result;
+    }
+
+    // [New] GPU time of the newest frame the profiler has read back, once per frame (call it on
+    // the thread that runs the GPU profiler)
+    auto latestGpuFrameMs = [](float& ms) {
+        static unsigned long long lastGpuFrame = 0;
+        if (GpuProfiler::GetHistory().empty() || GpuProfiler::GetHistory().back().Frame == lastGpuFrame)
+            return false;
+        lastGpuFrame = GpuProfiler::GetHistory().back().Frame;
+        ms = GpuProfiler::GetFrameGpuMs(GpuProfiler::GetHistory().back());
+        return true;
+    };
+
+    // [New] Frames in flight, on the thread that submits: wait for a free slot before the frame's GL
+    // work, fence the frame right before its swap. Frames the GPU finished close their clicks
+    auto waitForGpuSlot = []() {
+        frameLimiter.Wait();
+        latencyLog.Complete(frameLimiter.GetCompletedFrame(), frameLimiter.GetCompletedTime());
+    };
+    auto fenceFrame = [](const ClickTiming& click) {
+        unsigned long long frame = frameLimiter.Submit();
+        latencyLog.AddClick(click, frame, std::chrono::steady_clock::now());
+    };
+
+    // [New] --render-thread: this thread records the scene and the UI, the render thread runs the
+    // frame graph over them (its targets, GPU timers and TAA history are GL state) and swaps.
+    // Loading is done, so the context can move over now.
+    RenderCommandBuffer immediateCommands(true); // Without it the scene executes as it is recorded
+    if (renderThreaded) {
+        ImGui_ImplOpenGL3_NewFrame(); // Creates the backend's shader and font texture while the context is here
+        renderThread.Start(window, [&](RenderFrame& frame) {
+            waitForGpuSlot();
+            GpuProfiler::BeginFrame();
+            if (frame.Scene) {
+                frame.Commands.ProjectionJitter = postProcessor->GetProjectionJitter();
+                postProcessor->SetViewProjection(frame.ViewProjection);
+                GpuProfiler::Begin("Render");
+                postProcessor->Render(frame.Time, [&]() { frame.Commands.Replay(); });
+                GpuProfiler::End();
+            } else {
+                glViewport(0, 0, frame.FramebufferWidth, frame.FramebufferHeight);
+                glClear(GL_COLOR_BUFFER_BIT);
+            }
+            if (frame.GetUi()) {
+                GpuProfiler::Scope scope("ImGui");
+                ImGui_ImplOpenGL3_RenderDrawData(frame.GetUi());
+            }
+            GpuProfiler::EndFrame();
+            fenceFrame(frame.Click);
+            float gpuMs;
+            if (frame.Scene && latestGpuFrameMs(gpuMs)) {
+                std::lock_guard<std::mutex> guard(gpuFrameLock);
+                gpuFrameTimes.push_back(gpuMs);
+            }
+        });
+        std::cout << "Render thread: on (" << RenderThread::FRAME_SLOTS << " frames recorded ahead at most)" << std::endl;
+    }
+
+    framePipeline.Start(buildFrame);
+    bool cursorShown = false;
     while (!glfwWindowShouldClose(window)) {
+        // [New] Replay: this frame's recorded events (applied by pollInput) and delta time
+        float replayDeltaTime = 0.0f;
+        if (inputRecorder.GetMode() == InputRecorder::REPLAYING
+            && !inputRecorder.NextFrame(replayEvents, replayDeltaTime)) {
+            std::cout << "Input: replay finished after " << inputRecorder.GetFrame() << " frames" << std::endl;
+            break;
+        }
+
+        CGTP_PROFILE_SCOPE("Frame");
+        // CPU + GPU timings of the scopes below (read back a few frames later)
+        if (!renderThread.IsRunning())
+            GpuProfiler::BeginFrame();
+        RenderStats::BeginFrame();
+
         // [New] Menu & State Handling
         if (gameState != 3) {
-            // Input Poll
-            glfwPollEvents();
-            if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+            // Input Poll (the game thread has not started a frame yet: apply here)
+            pollInput();
+            for (const InputEvent& e : pendingInput)
+                applyInput(e);
+            pendingInput.clear();
+            pendingClickTime = std::chrono::steady_clock::time_point();
+            if (input.IsKeyDown(GLFW_KEY_ESCAPE))
                 glfwSetWindowShouldClose(window, true);
 
             // State Transition Logic
-            if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) {
+            if (input.IsKeyDown(GLFW_KEY_ENTER)) {
                 if (!enterPressed) {
                     enterPressed = true;
                     if (gameState == 0) gameState = 1;      // Start -> Story
@@ -219,7 +662,9 @@ int main()
                     else if (gameState == 2) {              // Instr -> Game
                         gameState = 3;
                         gameManager.ResetGame();
-                        lastFrame = static_cast<float>(glfwGetTime()); 
+                        lastFrame = glfwGetTime();
+                        simulationClock.Reset();
+                        previousCameraPosition = camera.Position;
                     }
                 }
             } else {
@@ -352,194 +797,343 @@ int main()
             ImGui::Render();
             int display_w, display_h;
             glfwGetFramebufferSize(window, &display_w, &display_h);
-            glViewport(0, 0, display_w, display_h);
-            glClear(GL_COLOR_BUFFER_BIT); // Clear previous
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-            
-            glfwSwapBuffers(window);
+            if (renderThread.IsRunning()) {
+                // [New] The render thread clears and draws a copy of the UI
+                RenderFrame& frame = renderThread.BeginFrame();
+                frame.FramebufferWidth = display_w;
+                frame.FramebufferHeight = display_h;
+                frame.SetUi(ImGui::GetDrawData());
+                renderThread.SubmitFrame();
+            } else {
+                waitForGpuSlot();
+                glViewport(0, 0, display_w, display_h);
+                glClear(GL_COLOR_BUFFER_BIT); // Clear previous
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+                GpuProfiler::EndFrame();
+                fenceFrame(ClickTiming());
+                glfwSwapBuffers(window);
+            }
+            inputRecorder.EndFrame(0.0f);
             continue; // Skip the rest of the loop
         }
 
         // ÿһ֡ʱ
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
+        double currentFrame = glfwGetTime();
+        float frameTime = static_cast<float>(currentFrame - lastFrame);
+        deltaTime = frameTime;
         lastFrame = currentFrame;
+        // [New] A replay feeds the recorded deltas into the clock, so it runs the recorded steps
+        // however fast this machine renders
+        if (inputRecorder.GetMode() == InputRecorder::REPLAYING)
+            deltaTime = replayDeltaTime;
+
+        // [New] Frame time statistics (the first game frame still carries the menu time)
+        static bool firstGameFrame = true;
+        if (!firstGameFrame) {
+            // A hitch capture reads the GPU profiler, which the render thread writes while it executes
+            std::unique_lock<std::mutex> state;
+            if (renderThread.IsRunning() && frameStats.IsCaptureDue())
+                state = std::unique_lock<std::mutex>(renderThread.GetStateLock());
+            frameStats.AddCpuFrame(frameTime * 1000.0f);
+        }
+        firstGameFrame = false;
+        float gpuMs;
+        if (renderThread.IsRunning()) {
+            std::lock_guard<std::mutex> guard(gpuFrameLock);
+            for (float ms : gpuFrameTimes)
+                frameStats.AddGpuFrame(ms);
+            gpuFrameTimes.clear();
+        } else if (latestGpuFrameMs(gpuMs)) {
+            frameStats.AddGpuFrame(gpuMs);
+        }
 
-        // [Added] Update Game Logic
-        gameManager.Update(deltaTime);
-
-        processInput(window);
-
-        // ImGui ֡
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        // 1.  (Render to MSAA FBO)
-        postProcessor->BeginRender();
-        // glClearColor(0.1f, 0.1f, 0.15f, 1.0f); // Moved to BeginRender
-        // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Moved to BeginRender
-
-        // 2.  Shader
-        ourShader.use();
-        
-        // [NEW] ݹ Uniforms
-        ourShader.setVec3("viewPos", camera.Position);
-        ourShader.setVec3("lightDirection", lightDirection);
-        ourShader.setFloat("time", static_cast<float>(glfwGetTime())); // [Added] Pass time
-        ourShader.setInt("objectType", 0); // [Added] Default to City Rendering
+        // [New] Hand this frame's input to the game thread and take the packet it built last
+        // frame. HUD and debug panel are built while the game thread waits: they read and
+        // change game state. The scene is submitted while the next packet is being built.
+        FrameInput frameInput;
+        frameInput.Events.swap(pendingInput);
+        frameInput.DeltaTime = deltaTime;
+        frameInput.Time = glfwGetTime();
+        frameInput.LookTotal = lookLatch.GetTotal();
+        frameInput.ClickTime = pendingClickTime;
+        pendingClickTime = std::chrono::steady_clock::time_point();
+        const RenderPacket& packet = framePipeline.Exchange(std::move(frameInput), [](const RenderPacket& p) {
+            // ImGui ֡
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+            drawHud(p);
+            if (showDebugPanel) {
+                // The panel changes post-processing settings and reads the GPU profiler: with a
+                // render thread, not while it executes a frame
+                std::unique_lock<std::mutex> state;
+                if (renderThread.IsRunning())
+                    state = std::unique_lock<std::mutex>(renderThread.GetStateLock());
+                drawDebugPanel();
+            }
+        });
+        if (packet.CloseRequested)
+            glfwSetWindowShouldClose(window, true);
+        if (packet.CursorVisible != cursorShown) {
+            cursorShown = packet.CursorVisible;
+            glfwSetInputMode(window, GLFW_CURSOR, cursorShown ? GLFW_CURSOR_NORMAL : GLFW_CURSOR_DISABLED);
+        }
 
-        // 3.  (View & Projection)
+        //  (View & Projection)
         //  Far Plane (Զƽ) õ 1000.0fֹԶе
-        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 1000.0f);
-        glm::mat4 view = camera.GetViewMatrix();
-        ourShader.setMat4("projection", projection);
-        ourShader.setMat4("view", view);
-
-        // 4. ģ (Model)
-        glm::mat4 model = glm::mat4(1.0f);
-
-        //  -5 (վڵ)Զ -10 (ȷҰ)
-        model = glm::translate(model, glm::vec3(0.0f, -5.0f, -10.0f));
-
-        // [FIX] ̬ Assimp ȡ GLTF ʱܱ Z-UpģͿŵ
-        //  X ת -90 ȣ Z  Y 
-        model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        
-        // [FIX] ģǷ(米)ͨҪ Y ת 180 
-        model = glm::rotate(model, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-
-        // 
-        model = glm::scale(model, glm::vec3(10.0f));
-
-        ourShader.setMat4("model", model);
-
-        // 5. 
-        // [Fix] ڻǰ󶨰ɫһ TU0
-        // ģе(texture_diffuse)Mesh::Draw ĴḲǰ
-        // ģûвʣShader ͻɫһ֡Ļ˸
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, whiteTexture);
-
-        ourModel.Draw(ourShader);
-
-        // [Added] Render Targets (Red Dots)
-        // Reset Model Matrix for Targets
-        gameManager.Render(ourShader);
-
-        // --- 3D Ⱦ ---
-
-        // 2. Post Processing (Resolve MSAA -> Draw Quad -> Screen)
-        postProcessor->EndRender(static_cast<float>(glfwGetTime()));
-
-        // [Modified] UI replaced with Game UI
-        // Use a full screen window for HUD to control positioning better
-        ImGui::SetNextWindowPos(ImVec2(0, 0));
-        ImGui::SetNextWindowSize(ImVec2((float)SCR_WIDTH, (float)SCR_HEIGHT));
-        ImGui::Begin("HUD", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoBackground);
-        
-        if (gameManager.IsGameOver()) {
-            // Darken background
-            ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)SCR_WIDTH, (float)SCR_HEIGHT), IM_COL32(0,0,0,200));
-            
-            // Center the text
-            const char* title = "MISSION COMPLETE";
-            ImGui::SetWindowFontScale(3.0f);
-            float titleW = ImGui::CalcTextSize(title).x;
-            ImGui::SetCursorPos(ImVec2((SCR_WIDTH - titleW)/2, SCR_HEIGHT/3));
-            ImGui::TextColored(ImVec4(0, 1, 1, 1), "%s", title); // Cyan Title
-            
-            ImGui::SetWindowFontScale(2.0f);
-            char scoreText[64];
-            sprintf(scoreText, "FINAL SCORE: %d", gameManager.GetScore());
-            float scoreW = ImGui::CalcTextSize(scoreText).x;
-            ImGui::SetCursorPos(ImVec2((SCR_WIDTH - scoreW)/2, SCR_HEIGHT/3 + 60));
-            ImGui::TextColored(ImVec4(1, 1, 1, 1), "%s", scoreText);
-
-            // Instructions
-            const char* sub = "Press Enter to Restart";
-            ImGui::SetWindowFontScale(1.5f);
-            float subW = ImGui::CalcTextSize(sub).x;
-            ImGui::SetCursorPos(ImVec2((SCR_WIDTH - subW)/2, SCR_HEIGHT/3 + 120));
-            if (sin(glfwGetTime() * 5.0f) > 0.0f) // Blink
-                ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s", sub);
-
-            if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) {
-                gameManager.ResetGame();
+        // TAA jitters the projection every frame; reprojection uses the unjittered matrices
+        // [Modified] The scene records the unjittered projection, the jitter is added when it executes
+        // [New] Wait for room first (a render thread slot, or a GPU frame in flight), then poll once
+        // more and late-latch the view: it follows the mouse as of now, not as of the packet's build
+        RenderFrame* frame = nullptr;
+        if (renderThread.IsRunning())
+            frame = &renderThread.BeginFrame();
+        else
+            waitForGpuSlot();
+        Camera eye = packet.Eye;
+        if (lookLatch.Enabled && !packet.CursorVisible) {
+            pollInput();
+            eye = lookLatch.Apply(packet.Eye, packet.LookTotal);
+        }
+        const float aspect = (float)SCR_WIDTH / (float)SCR_HEIGHT;
+        glm::mat4 projection = eye.GetProjectionMatrix(aspect, 0.1f, 1000.0f, false);
+        glm::mat4 view = eye.GetViewMatrix();
+
+        if (frame) {
+            // [New] Record the scene, copy the UI; the render thread executes both and swaps
+            frame->Scene = true;
+            frame->Click = packet.Click;
+            frame->Time = packet.Time;
+            frame->ViewProjection = projection * view;
+            drawScene(packet, projection, view, frame->Commands);
+            {
+                CGTP_PROFILE_SCOPE("ImGui");
+                ImGui::Render();
+                frame->SetUi(ImGui::GetDrawData());
             }
+            renderThread.SubmitFrame();
         } else {
-            // HUD Top Bar
-            ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(0,0), ImVec2(SCR_WIDTH, 60), IM_COL32(0,0,0,150));
-            ImGui::GetWindowDrawList()->AddLine(ImVec2(0,60), ImVec2(SCR_WIDTH, 60), IM_COL32(0, 255, 255, 255), 2.0f);
-
-            // Timer
-            float t = gameManager.GetTimeLeft();
-            int minutes = (int)(t / 60);
-            int seconds = (int)(t) % 60;
-            char timeStr[32];
-            sprintf(timeStr, "%02d:%02d", minutes, seconds);
-
-            ImGui::SetWindowFontScale(2.0f);
-            ImGui::SetCursorPos(ImVec2(20, 10));
-            ImGui::TextColored(ImVec4(1, 0, 0, 1), "TIME: %s", timeStr);
-
-            // Score
-            char scoreStr[32];
-            sprintf(scoreStr, "TARGETS: %d", gameManager.GetScore());
-            float scoreW = ImGui::CalcTextSize(scoreStr).x;
-            ImGui::SetCursorPosX(SCR_WIDTH - scoreW - 20);
-            ImGui::SetCursorPosY(10);
-            ImGui::TextColored(ImVec4(0, 1, 1, 1), "%s", scoreStr);
-            
-            // Instructions (Bottom Left)
-            ImGui::SetWindowFontScale(1.0f);
-            ImGui::SetCursorPos(ImVec2(20, SCR_HEIGHT - 120));
-            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "INSTRUCTIONS:");
-            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Find RED DOTS");
-            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Zoom Scroll < 20 FOV");
-            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Left Click to Scan");
-        }
-        
-        // Draw Crosshair
-        if (!gameManager.IsGameOver()) {
-            ImDrawList* draw_list = ImGui::GetWindowDrawList();
-            draw_list->AddCircle(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2), 5.0f, IM_COL32(255, 0, 0, 200));
-            draw_list->AddCircle(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2), 20.0f, IM_COL32(255, 0, 0, 100), 0, 1.0f);
-            draw_list->AddLine(ImVec2(SCR_WIDTH/2 - 10, SCR_HEIGHT/2), ImVec2(SCR_WIDTH/2 + 10, SCR_HEIGHT/2), IM_COL32(255, 0, 0, 150));
-            draw_list->AddLine(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2 - 10), ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2 + 10), IM_COL32(255, 0, 0, 150));
-        }
-
-        ImGui::End();
-
-        // 2. ImGui
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            immediateCommands.ProjectionJitter = postProcessor->GetProjectionJitter();
+            postProcessor->SetViewProjection(projection * view);
+
+            // 1. Frame graph: Scene -> [TAA] -> Bloom -> Composite -> [FXAA / SMAA] -> screen
+            // The lambda is the scene pass; it runs inside Render with the scene target bound
+            GpuProfiler::Begin("Render");
+            postProcessor->Render(packet.Time, [&]() {
+                drawScene(packet, projection, view, immediateCommands);
+            });
+            GpuProfiler::End();
+
+            // 2. ImGui
+            {
+                CGTP_PROFILE_SCOPE("ImGui");
+                GpuProfiler::Scope scope("ImGui");
+                ImGui::Render();
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
 
-        // 3. 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            // 3. 
+            GpuProfiler::EndFrame();
+            fenceFrame(packet.Click);
+            glfwSwapBuffers(window);
+        }
+        pollInput();
+        inputRecorder.EndFrame(deltaTime);
     }
+    framePipeline.Stop();
+    renderThread.Stop(); // The context comes back for the GL cleanup below
+    inputRecorder.Stop();
+    frameLimiter.Release();
+    latencyLog.Close();
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
     
     delete postProcessor;
+
+    frameStats.WriteJson("frame_stats.json");
     
+    JobSystem::Shutdown();
     glfwTerminate();
     return 0;
 }
 
-void processInput(GLFWwindow* window) {
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
+// [New] Headless benchmark loop: fixed 60 Hz simulation step and a slow camera pan (or the scripted
+// camera path), so every run renders the same frames. Records frame-to-frame CPU time, (read back
+// later) GPU time and the draw counters of every frame.
+int runHeadless(const HeadlessOptions& options, const ScenePrepareFn& prepareScene, const SceneDrawFn& drawScene) {
+    CameraPath path;
+    const bool scripted = !options.PathFile.empty();
+    int frameCount = options.Frames > 0 ? options.Frames : 600;
+    if (scripted) {
+        std::string error;
+        if (!path.Load(options.PathFile, error)) {
+            std::cout << "ERROR::BENCHMARK:: " << error << std::endl;
+            return -1;
+        }
+        // The path's own count unless overridden; the report records both
+        if (options.Frames == 0)
+            frameCount = path.GetFrameCount();
+    }
+
+    Framebuffer output(options.Width, options.Height, false, GL_RGBA8, false);
+    postProcessor->SetOutputTarget(&output);
+    postProcessor->GetDynamicResolution()->Enabled = options.DynamicResolution;
+    if (options.AAMode >= 0)
+        postProcessor->AAMode = static_cast<AA_Mode>(options.AAMode);
+    frameStats.CaptureHitches = false; // Keep disk writes out of the measurement
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.OutDir, ec);
+    // Same spawns every run; the drone budget window follows wall time, so step every drone
+    gameManager.SetSeed(1);
+    if (options.Drones > 0) {
+        gameManager.SetDroneMode(true, options.Drones);
+        gameManager.GetDroneSwarm().BudgetMs = 1e9f;
+    }
+    gameManager.ResetGame();
+
+    const float dt = 1.0f / 60.0f;
+    const float aspect = (float)options.Width / (float)options.Height;
+    BenchmarkReport report;
+    report.Frames.resize(frameCount);
+    report.Renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    report.GLVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    report.AAMode = PostProcessor::GetAAModeName(postProcessor->AAMode);
+    report.Width = options.Width;
+    report.Height = options.Height;
+    report.DynamicResolution = options.DynamicResolution;
+    report.Drones = options.Drones;
+    report.LoadMs = startupMs;
+    std::vector<unsigned char> pixels;
+    RenderPacket packet;
+    RenderCommandBuffer commands(true); // Executes as it is recorded, like the single-threaded game loop
+    unsigned long long firstMeasuredFrame = 0, lastGpuFrame = 0;
+
+    // GPU times arrive a few frames late; match them to recorded frames by profiler frame number
+    auto collectGpuTimes = [&]() {
+        for (const GpuProfiler::FrameRecord& record : GpuProfiler::GetHistory()) {
+            if (record.Frame <= lastGpuFrame) continue;
+            lastGpuFrame = record.Frame;
+            if (firstMeasuredFrame == 0 || record.Frame < firstMeasuredFrame) continue;
+            unsigned long long index = record.Frame - firstMeasuredFrame;
+            if (index >= report.Frames.size()) continue;
+            report.Frames[index].GpuMs = GpuProfiler::GetFrameGpuMs(record);
+            frameStats.AddGpuFrame(report.Frames[index].GpuMs);
+        }
+    };
+
+    std::cout << "Headless: " << options.Warmup << " + " << frameCount << " frames at "
+              << options.Width << "x" << options.Height << ", " << report.AAMode;
+    if (scripted)
+        std::cout << ", path " << path.GetName() << " r" << path.GetRevision() << " (" << path.GetSegments().size() << " segments)";
+    std::cout << std::endl;
+    auto previous = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < options.Warmup + frameCount; frame++) {
+        CGTP_PROFILE_SCOPE("Frame");
+        const int measured = frame - options.Warmup;
+        GpuProfiler::BeginFrame();
+        RenderStats::BeginFrame();
+        if (measured == 0)
+            firstMeasuredFrame = GpuProfiler::GetFrameIndex();
+        collectGpuTimes();
+
+        const float time = frame * dt;
+        GpuProfiler::Begin("Update");
+        gameManager.Update(dt);
+        if (scripted) {
+            // Warmup holds the first pose; the measured frames spread evenly over the path
+            float pathTime = measured > 0 ? path.GetDuration() * measured / (frameCount - 1) : 0.0f;
+            CameraPath::Pose pose = path.Evaluate(pathTime);
+            camera.SetPose(pose.Position, pose.Yaw, pose.Pitch);
+            camera.Zoom = pose.Zoom;
+            if (measured >= 0)
+                report.Frames[measured].Segment = path.SegmentAt(pathTime);
+        } else {
+            camera.ProcessMouseMovement(0.5f, 0.0f);
+        }
+        GpuProfiler::End();
+
+        // Same packet as the game thread builds, built inline (one thread keeps the timings comparable)
+        packet.Eye = camera;
+        packet.Time = time;
+        prepareScene(packet, aspect, 0.0f);
+
+        commands.ProjectionJitter = postProcessor->GetProjectionJitter();
+        glm::mat4 projection = packet.Eye.GetProjectionMatrix(aspect, 0.1f, 1000.0f, false);
+        glm::mat4 view = packet.Eye.GetViewMatrix();
+        postProcessor->SetViewProjection(projection * view);
+
+        GpuProfiler::Begin("Render");
+        postProcessor->Render(time, [&]() { drawScene(packet, projection, view, commands); });
+        GpuProfiler::End();
+        GpuProfiler::EndFrame();
+        glFlush(); // Stands in for the swap: submit now, the driver throttles if the GPU falls behind
+        report.RenderTargetMb = std::max(report.RenderTargetMb, postProcessor->GetTargetPool()->GetMemoryBytes() / (1024.0f * 1024.0f));
+
+        auto now = std::chrono::steady_clock::now();
+        if (measured >= 0) {
+            BenchmarkReport::Frame& record = report.Frames[measured];
+            record.CpuMs = std::chrono::duration<float, std::milli>(now - previous).count();
+            record.Stats = RenderStats::GetCurrent();
+            frameStats.AddCpuFrame(record.CpuMs);
+        }
+
+        if (measured >= 0 && options.PngEvery > 0 && measured % options.PngEvery == 0) {
+            pixels.resize(static_cast<size_t>(options.Width) * options.Height * 4);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, output.ID);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, options.Width, options.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            char name[64];
+            std::snprintf(name, sizeof(name), "/frame_%05d.png", measured);
+            PngWriter::Write(options.OutDir + name, options.Width, options.Height, 4, pixels.data(), true);
+            now = std::chrono::steady_clock::now(); // The dump is not part of the next frame
+        }
+        previous = now;
+    }
+
+    // Let the GPU finish, then pick up the last timings
+    glFinish();
+    GpuProfiler::BeginFrame();
+    GpuProfiler::EndFrame();
+    collectGpuTimes();
+    postProcessor->SetOutputTarget(nullptr);
+
+    report.PeakRssMb = BenchmarkReport::QueryPeakRssMb();
+    report.WriteCsv(options.OutDir + "/frames.csv", scripted ? &path : nullptr);
+    if (scripted)
+        report.WriteJson(options.OutDir + "/benchmark.json", path);
+    frameStats.WriteJson(options.OutDir + "/frame_stats.json");
+    GpuProfiler::ExportChromeTrace(options.OutDir + "/gpu_trace.json");
+
+    FrameStats::Summary cpu = frameStats.GetCpuSummary();
+    FrameStats::Summary gpu = frameStats.GetGpuSummary();
+    std::printf("Headless: frame p50 %.2f p95 %.2f p99 %.2f max %.2f ms | GPU p50 %.2f p95 %.2f p99 %.2f max %.2f ms (%lld frames)\n",
+        cpu.P50, cpu.P95, cpu.P99, cpu.Max, gpu.P50, gpu.P95, gpu.P99, gpu.Max, gpu.Frames);
+    return 0;
+}
+
+// [Modified] Runs on the game thread: window changes go out through the packet
+void processInput(RenderPacket& packet) {
+    packet.CloseRequested = input.IsKeyDown(GLFW_KEY_ESCAPE);
+
+    // Restart after the mission ends [Enter]
+    if (gameManager.IsGameOver() && input.IsKeyDown(GLFW_KEY_ENTER))
+        gameManager.ResetGame();
 
     // [Added] Handle Shooting (Mouse Left Click)
     static bool leftMousePressed = false;
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
+    if (input.IsMouseButtonDown(GLFW_MOUSE_BUTTON_LEFT)) {
         if (!leftMousePressed) {
             bool validHit = false;
-            if (gameManager.CheckShot(camera, validHit)) {
+            packet.Click.Valid = true; // [New] Latency log: this frame handled a click
+            packet.Click.Hit = gameManager.CheckShot(camera, validHit);
+            packet.Click.Shot = std::chrono::steady_clock::now();
+            if (packet.Click.Hit) {
                  std::cout << "Target Neutralized!" << std::endl;
             } else {
                  // std::cout << "Missed or Zoom insufficient." << std::endl;
@@ -552,13 +1146,9 @@ void processInput(GLFWwindow* window) {
 
     // Toggle Cursor Visibility [Alt Key]
     static bool altKeyPressed = false;
-    if (glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS) {
+    if (input.IsKeyDown(GLFW_KEY_LEFT_ALT)) {
         if (!altKeyPressed) {
             isCursorVisible = !isCursorVisible;
-            if (isCursorVisible)
-                glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-            else
-                glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
             
             // Only toggle once per press
             altKeyPressed = true;
@@ -566,26 +1156,52 @@ void processInput(GLFWwindow* window) {
     } else {
         altKeyPressed = false;
     }
+    packet.CursorVisible = isCursorVisible;
+
+    // [New] Save a CPU profiler capture [F9]
+    static bool f9KeyPressed = false;
+    if (input.IsKeyDown(GLFW_KEY_F9)) {
+        if (!f9KeyPressed) {
+            Profiler::SaveCapture("cpu_trace.json");
+            f9KeyPressed = true;
+        }
+    } else {
+        f9KeyPressed = false;
+    }
+
+    // [New] Toggle Debug Panel [F1] (use Alt to get the cursor for it)
+    static bool f1KeyPressed = false;
+    if (input.IsKeyDown(GLFW_KEY_F1)) {
+        if (!f1KeyPressed) {
+            showDebugPanel = !showDebugPanel;
+            f1KeyPressed = true;
+        }
+    } else {
+        f1KeyPressed = false;
+    }
+}
 
+// [New] Player movement for one simulation step (fixed dt, so speed and collision do not depend on the frame rate)
+void stepPlayer(float dt) {
     // [Modified] Disable camera ROTATION when cursor is visible, but allow MOVEMENT (WASD)
     // if (isCursorVisible) return; // Removed global block
 
     // WASD 
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        camera.ProcessKeyboard(FORWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        camera.ProcessKeyboard(BACKWARD, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        camera.ProcessKeyboard(LEFT, deltaTime);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        camera.ProcessKeyboard(RIGHT, deltaTime);
+    if (input.IsKeyDown(GLFW_KEY_W))
+        camera.ProcessKeyboard(FORWARD, dt);
+    if (input.IsKeyDown(GLFW_KEY_S))
+        camera.ProcessKeyboard(BACKWARD, dt);
+    if (input.IsKeyDown(GLFW_KEY_A))
+        camera.ProcessKeyboard(LEFT, dt);
+    if (input.IsKeyDown(GLFW_KEY_D))
+        camera.ProcessKeyboard(RIGHT, dt);
 
     // ֱ (ѡ)
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS)
-        camera.ProcessKeyboard(UP, deltaTime);
+    if (input.IsKeyDown(GLFW_KEY_SPACE))
+        camera.ProcessKeyboard(UP, dt);
     // [Changed] Use Left Control instead of Shift to avoid IME conflict
-    if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS)
-        camera.ProcessKeyboard(DOWN, deltaTime);
+    if (input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || input.IsKeyDown(GLFW_KEY_C))
+        camera.ProcessKeyboard(DOWN, dt);
 
     // [Removed] Right Mouse Button Zoom Logic
     // User requested to use Scroll Wheel instead.
@@ -594,7 +1210,7 @@ void processInput(GLFWwindow* window) {
     /*
     // ʵ֡۱佹 
     // ҼFOV С (Ŵ)
-    if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) {
+    if (input.IsMouseButtonDown(GLFW_MOUSE_BUTTON_RIGHT)) {
         camera.ProcessZoom(2.0f); // С FOV
     }
     else {
@@ -629,13 +1245,384 @@ void processInput(GLFWwindow* window) {
     */
 }
 
-// ƶصӽ
-void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
+// [New] Game HUD from the packet being drawn (split out of the main loop)
+void drawHud(const RenderPacket& packet)
+{
+    // [Modified] UI replaced with Game UI
+    // Use a full screen window for HUD to control positioning better
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2((float)SCR_WIDTH, (float)SCR_HEIGHT));
+    ImGui::Begin("HUD", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoBackground);
+    
+    if (packet.GameOver) {
+        // Darken background
+        ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)SCR_WIDTH, (float)SCR_HEIGHT), IM_COL32(0,0,0,200));
+        
+        // Center the text
+        const char* title = "MISSION COMPLETE";
+        ImGui::SetWindowFontScale(3.0f);
+        float titleW = ImGui::CalcTextSize(title).x;
+        ImGui::SetCursorPos(ImVec2((SCR_WIDTH - titleW)/2, SCR_HEIGHT/3));
+        ImGui::TextColored(ImVec4(0, 1, 1, 1), "%s", title); // Cyan Title
+        
+        ImGui::SetWindowFontScale(2.0f);
+        char scoreText[64];
+        sprintf(scoreText, "FINAL SCORE: %d", packet.Score);
+        float scoreW = ImGui::CalcTextSize(scoreText).x;
+        ImGui::SetCursorPos(ImVec2((SCR_WIDTH - scoreW)/2, SCR_HEIGHT/3 + 60));
+        ImGui::TextColored(ImVec4(1, 1, 1, 1), "%s", scoreText);
+
+        // Instructions
+        const char* sub = "Press Enter to Restart";
+        ImGui::SetWindowFontScale(1.5f);
+        float subW = ImGui::CalcTextSize(sub).x;
+        ImGui::SetCursorPos(ImVec2((SCR_WIDTH - subW)/2, SCR_HEIGHT/3 + 120));
+        if (sin(glfwGetTime() * 5.0f) > 0.0f) // Blink
+            ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s", sub);
+    } else {
+        // HUD Top Bar
+        ImGui::GetWindowDrawList()->AddRectFilled(ImVec2(0,0), ImVec2(SCR_WIDTH, 60), IM_COL32(0,0,0,150));
+        ImGui::GetWindowDrawList()->AddLine(ImVec2(0,60), ImVec2(SCR_WIDTH, 60), IM_COL32(0, 255, 255, 255), 2.0f);
+
+        // Timer
+        float t = packet.TimeLeft;
+        int minutes = (int)(t / 60);
+        int seconds = (int)(t) % 60;
+        char timeStr[32];
+        sprintf(timeStr, "%02d:%02d", minutes, seconds);
+
+        ImGui::SetWindowFontScale(2.0f);
+        ImGui::SetCursorPos(ImVec2(20, 10));
+        ImGui::TextColored(ImVec4(1, 0, 0, 1), "TIME: %s", timeStr);
+
+        // Score
+        char scoreStr[32];
+        sprintf(scoreStr, "TARGETS: %d", packet.Score);
+        float scoreW = ImGui::CalcTextSize(scoreStr).x;
+        ImGui::SetCursorPosX(SCR_WIDTH - scoreW - 20);
+        ImGui::SetCursorPosY(10);
+        ImGui::TextColored(ImVec4(0, 1, 1, 1), "%s", scoreStr);
+
+        // [New] Visual lock: anomalies inside the current field of view (counted by the game thread)
+        int signalsInView = packet.SignalsInView;
+        char signalStr[32];
+        sprintf(signalStr, "SIGNALS IN VIEW: %d", signalsInView);
+        ImGui::SetWindowFontScale(1.2f);
+        float signalW = ImGui::CalcTextSize(signalStr).x;
+        ImGui::SetCursorPos(ImVec2(SCR_WIDTH - signalW - 20, 70));
+        ImGui::TextColored(signalsInView > 0 ? ImVec4(1, 0.3f, 0.3f, 1) : ImVec4(0.5f, 0.5f, 0.5f, 1), "%s", signalStr);
+        
+        // Instructions (Bottom Left)
+        ImGui::SetWindowFontScale(1.0f);
+        ImGui::SetCursorPos(ImVec2(20, SCR_HEIGHT - 120));
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "INSTRUCTIONS:");
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Find RED DOTS");
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Zoom Scroll < 20 FOV");
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "- Left Click to Scan");
+    }
+    
+    // Draw Crosshair
+    if (!packet.GameOver) {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddCircle(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2), 5.0f, IM_COL32(255, 0, 0, 200));
+        // [New] Outer ring turns green when a target sits inside the lock cone
+        bool locked = packet.TargetLocked;
+        draw_list->AddCircle(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2), 20.0f, locked ? IM_COL32(0, 255, 0, 200) : IM_COL32(255, 0, 0, 100), 0, 1.0f);
+        draw_list->AddLine(ImVec2(SCR_WIDTH/2 - 10, SCR_HEIGHT/2), ImVec2(SCR_WIDTH/2 + 10, SCR_HEIGHT/2), IM_COL32(255, 0, 0, 150));
+        draw_list->AddLine(ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2 - 10), ImVec2(SCR_WIDTH/2, SCR_HEIGHT/2 + 10), IM_COL32(255, 0, 0, 150));
+    }
+
+    ImGui::End();
+}
+
+// [New]  (F1)
+void drawDebugPanel()
+{
+    ImGui::SetNextWindowPos(ImVec2(20, 80), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Debug", &showDebugPanel, ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("FPS: %.1f (%.2f ms)", ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
+
+    if (ImGui::CollapsingHeader("Targets", ImGuiTreeNodeFlags_DefaultOpen)) {
+        static bool droneMode = gameManager.IsDroneMode();
+        static int droneCount = gameManager.GetDroneCount();
+        ImGui::Checkbox("Drone Mode", &droneMode);
+        ImGui::SliderInt("Drones", &droneCount, 100, 50000);
+        if (ImGui::Button("Apply & Restart")) {
+            gameManager.SetDroneMode(droneMode, droneCount);
+            gameManager.ResetGame();
+        }
+
+        DroneSwarm& swarm = gameManager.GetDroneSwarm();
+        ImGui::SliderFloat("Budget (ms)", &swarm.BudgetMs, 0.5f, 8.0f);
+        ImGui::Text("Live targets: %zu", gameManager.GetTargets().Size());
+        if (gameManager.IsDroneMode()) {
+            ImGui::Text("Swarm kernel: %.2f ms, %zu stepped, %d threads",
+                swarm.GetLastUpdateMs(), swarm.GetLastSteppedCount(), swarm.GetThreadCount());
+            ImGui::Text("Obstacles: %zu", swarm.GetObstacleCount());
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Post FX", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Checkbox("Glitch", &postProcessor->UseGlitch);
+        ImGui::SameLine();
+        ImGui::Checkbox("Rain", &postProcessor->UseRain);
+        ImGui::SameLine();
+        ImGui::Checkbox("Tonemap", &postProcessor->UseTonemap);
+        ImGui::SameLine();
+        ImGui::Checkbox("Vignette", &postProcessor->UseVignette);
+        if (postProcessor->UseTonemap)
+            ImGui::SliderFloat("Exposure", &postProcessor->Exposure, 0.1f, 4.0f);
+        if (postProcessor->UseVignette)
+            ImGui::SliderFloat("Vignette Strength", &postProcessor->VignetteStrength, 0.0f, 1.0f);
+        ImGui::Text("Post shader variant 0x%02X (%zu compiled)", postProcessor->GetFeatureMask(), postProcessor->GetVariantCount());
+        ImGui::Text("Shader cache: %d hits, %d misses (binary %s, parallel %s)", ShaderCache::GetHits(), ShaderCache::GetMisses(),
+            ShaderCache::HasProgramBinary() ? "on" : "off", ShaderCache::HasParallelCompile() ? "on" : "off");
+
+        ImGui::Checkbox("Bloom", &postProcessor->UseBloom);
+        int bloomMode = postProcessor->BloomMode;
+        if (ImGui::Combo("Bloom Mode", &bloomMode, "Gaussian (10 full-res passes)\0Mip chain\0"))
+            postProcessor->BloomMode = static_cast<Bloom_Mode>(bloomMode);
+        ImGui::SliderFloat("Intensity", &postProcessor->BloomIntensity, 0.0f, 4.0f);
+        BloomRenderer* bloom = postProcessor->GetBloomRenderer();
+        if (postProcessor->BloomMode == BLOOM_MIPCHAIN) {
+            ImGui::SliderFloat("Threshold", &bloom->Threshold, 0.0f, 4.0f);
+            ImGui::SliderFloat("Radius", &bloom->FilterRadius, 0.5f, 3.0f);
+        }
+        RenderTargetPool* pool = postProcessor->GetTargetPool();
+        ImGui::Text("Render targets: %zu (%.1f MB), %d created this frame",
+            pool->GetTargetCount(), pool->GetMemoryBytes() / (1024.0f * 1024.0f), pool->GetCreatedThisFrame());
+        // Each mode keeps its last measurement, so switching back and forth compares both
+        ImGui::Text("Bloom GPU: Gaussian %.3f ms | Mip chain (%d levels) %.3f ms",
+            postProcessor->GetBloomGpuMs(BLOOM_GAUSSIAN), bloom->GetMipCount(), postProcessor->GetBloomGpuMs(BLOOM_MIPCHAIN));
+    }
+
+    if (ImGui::CollapsingHeader("Dynamic Resolution", ImGuiTreeNodeFlags_DefaultOpen)) {
+        // Only the 3D scene is scaled; post output and this UI stay at the window size
+        DynamicResolution* dynRes = postProcessor->GetDynamicResolution();
+        ImGui::Checkbox("Enabled", &dynRes->Enabled);
+        ImGui::SameLine();
+        ImGui::Checkbox("Bicubic Upscale", &postProcessor->BicubicUpscale);
+        ImGui::SliderFloat("Target GPU (ms)", &dynRes->TargetMs, 4.0f, 33.3f);
+        ImGui::SliderFloat("Min Scale", &dynRes->MinScale, 0.25f, 1.0f);
+        ImGui::SliderFloat("Max Scale", &dynRes->MaxScale, dynRes->MinScale, 1.0f);
+        ImGui::Text("Scale %.2f: %dx%d -> %ux%u, GPU %.2f ms, %d changes", dynRes->GetScale(),
+            postProcessor->GetRenderWidth(), postProcessor->GetRenderHeight(), postProcessor->Width, postProcessor->Height,
+            dynRes->GetLastGpuMs(), dynRes->GetChangeCount());
+    }
+
+    if (ImGui::CollapsingHeader("Anti-Aliasing", ImGuiTreeNodeFlags_DefaultOpen)) {
+        int aaMode = postProcessor->AAMode;
+        if (ImGui::Combo("AA Mode", &aaMode, "Off\0MSAA 2x\0MSAA 4x\0MSAA 8x\0FXAA\0SMAA 1x\0TAA\0TAAU (temporal upscale)\0"))
+            postProcessor->AAMode = static_cast<AA_Mode>(aaMode);
+        if (postProcessor->AAMode == AA_MSAA8 && postProcessor->GetMaxSamples() < 8)
+            ImGui::Text("Driver limit: %d samples", postProcessor->GetMaxSamples());
+        if (postProcessor->AAMode == AA_SMAA)
+            ImGui::SliderFloat("Edge Threshold", &postProcessor->SMAAThreshold, 0.05f, 0.2f);
+        if (postProcessor->AAMode == AA_TAA || postProcessor->AAMode == AA_TAAU)
+            ImGui::SliderFloat("History Weight", &postProcessor->TAAFeedback, 0.5f, 0.97f);
+        if (postProcessor->AAMode == AA_TAAU)
+            ImGui::SliderFloat("TAAU Scale", &postProcessor->TAAUScale, 0.5f, 0.77f);
+
+        // Every mode keeps its last measurement; cycle through them to fill the table
+        ImGui::Text("%-8s %10s %10s %10s", "Mode", "Targets", "Frame GPU", "AA GPU");
+        for (int m = 0; m < AA_MODE_COUNT; m++) {
+            const PostProcessor::AAStats& stats = postProcessor->GetAAStats(static_cast<AA_Mode>(m));
+            if (!stats.Measured) {
+                ImGui::TextDisabled("%-8s %10s", PostProcessor::GetAAModeName(static_cast<AA_Mode>(m)), "-");
+                continue;
+            }
+            ImGui::Text("%-8s %7.1f MB %7.3f ms %7.3f ms", PostProcessor::GetAAModeName(static_cast<AA_Mode>(m)),
+                stats.TargetBytes / (1024.0f * 1024.0f), stats.FrameGpuMs, stats.AAGpuMs);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Draw Stats", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const RenderStats::Counters& stats = RenderStats::GetLastFrame();
+        ImGui::Checkbox("Frustum culling", &frustumCulling);
+        ImGui::Text("Draw calls: %d", stats.DrawCalls);
+        ImGui::Text("Triangles: %.2f M", stats.Triangles / 1000000.0);
+        ImGui::Text("City meshes culled: %d / %d", stats.MeshesCulled, stats.MeshesTested);
+    }
+
+    if (ImGui::CollapsingHeader("Simulation", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Fixed step: %.1f Hz, %d step(s) this frame, alpha %.2f",
+            1.0 / simulationClock.Step, simulationClock.GetLastSteps(), simulationClock.GetAlpha());
+        ImGui::Text("Steps: %lld, dropped %.2f s (cap %d per frame)",
+            simulationClock.GetStepCount(), simulationClock.GetDroppedTime(), simulationClock.MaxSteps);
+        // [New] Off: build and submit one after the other on this thread (compare the frame times)
+        ImGui::Checkbox("Pipelined (game thread builds the next frame)", &framePipeline.Threaded);
+        ImGui::Text("Build %.2f ms, GL thread waited %.2f ms for it",
+            framePipeline.GetLastBuildMs(), framePipeline.GetLastWaitMs());
+        // [New] --render-thread (the panel holds the state lock, so the render thread is between frames)
+        if (renderThread.IsRunning())
+            ImGui::Text("Render thread: %.2f ms, %zu commands (%.1f KB); waited %.2f ms for a slot",
+                renderThread.GetLastExecuteMs(), renderThread.GetLastCommandCount(),
+                renderThread.GetLastCommandBytes() / 1024.0f, renderThread.GetLastWaitMs());
+    }
+
+    // [New] Frames in flight (the render thread's limiter too: the panel holds the state lock)
+    if (ImGui::CollapsingHeader("Latency", ImGuiTreeNodeFlags_DefaultOpen)) {
+        // 1 = lowest latency; more keeps the GPU busy through CPU spikes
+        ImGui::SliderInt("Frames in flight", &frameLimiter.MaxFramesInFlight, 0, FrameLimiter::MAX_FRAMES_IN_FLIGHT,
+            frameLimiter.MaxFramesInFlight == 0 ? "no cap" : "%d");
+        ImGui::Checkbox("Late-latch camera orientation", &lookLatch.Enabled);
+        ImGui::Text("In flight: %d, waited %.2f ms for the GPU", frameLimiter.GetFramesInFlight(), frameLimiter.GetLastWaitMs());
+        if (latencyLog.IsOpen())
+            ImGui::Text("Click -> GPU done: last %.1f ms, average %.1f ms (%d clicks)",
+                latencyLog.GetLastMs(), latencyLog.GetAverageMs(), latencyLog.GetClickCount());
+    }
+
+    if (ImGui::CollapsingHeader("Jobs", ImGuiTreeNodeFlags_DefaultOpen)) {
+        // Sampled twice a second so the bars are readable
+        static std::vector<JobSystem::WorkerStats> workers;
+        static double lastSample = -1.0;
+        double now = glfwGetTime();
+        if (lastSample < 0.0 || now - lastSample >= 0.5) {
+            JobSystem::SampleStats(workers);
+            lastSample = now;
+        }
+        ImGui::Text("Threads: %d", JobSystem::GetThreadCount());
+        for (const JobSystem::WorkerStats& w : workers) {
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "%.0f%%  %lld jobs, %lld stolen", w.Utilization * 100.0f, w.Jobs, w.Steals);
+            ImGui::ProgressBar(w.Utilization, ImVec2(-80.0f, 0.0f), overlay);
+            ImGui::SameLine();
+            ImGui::TextUnformatted(w.Name.c_str());
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Frame Times", ImGuiTreeNodeFlags_DefaultOpen)) {
+        FrameStats::Summary cpu = frameStats.GetCpuSummary();
+        FrameStats::Summary gpu = frameStats.GetGpuSummary();
+        if (ImGui::BeginTable("frametimes", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("max");
+            ImGui::TableSetupColumn("over budget");
+            ImGui::TableSetupColumn("frames");
+            ImGui::TableHeadersRow();
+            const char* rowNames[2] = { "Frame", "GPU" };
+            const FrameStats::Summary* rows[2] = { &cpu, &gpu };
+            for (int r = 0; r < 2; r++) {
+                const FrameStats::Summary& s = *rows[r];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(rowNames[r]);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.P50);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.P95);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.P99);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", s.Max);
+                ImGui::TableNextColumn(); ImGui::Text("%lld (%.1f%%)", s.OverBudget, s.Frames ? 100.0 * s.OverBudget / s.Frames : 0.0);
+                ImGui::TableNextColumn(); ImGui::Text("%lld", s.Frames);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::SliderFloat("Budget (ms)", &frameStats.BudgetMs, 4.0f, 50.0f, "%.1f");
+        ImGui::SliderFloat("Hitch (x median)", &frameStats.HitchFactor, 1.5f, 5.0f, "%.1f");
+        ImGui::Checkbox("Save profiler data on hitch", &frameStats.CaptureHitches);
+        const std::vector<FrameStats::Hitch>& hitches = frameStats.GetHitches();
+        ImGui::Text("Median %.2f ms, %d hitches", frameStats.GetRecentMedianMs(), static_cast<int>(hitches.size()));
+        if (!hitches.empty()) {
+            const FrameStats::Hitch& last = hitches.back();
+            ImGui::TextDisabled("Last: frame %lld, %.1f ms (median %.1f) %s", last.Frame, last.Ms, last.MedianMs, last.Files.c_str());
+        }
+        if (ImGui::Button("Reset"))
+            frameStats.Reset();
+    }
+
+    if (ImGui::CollapsingHeader("GPU Profiler")) {
+        ImGui::Checkbox("Record", &GpuProfiler::Enabled);
+        const std::deque<GpuProfiler::FrameRecord>& frames = GpuProfiler::GetHistory();
+
+        // Rolling graphs: GPU time of the top-level scopes and CPU frame time
+        static float gpuFrameMs[GpuProfiler::HISTORY_FRAMES];
+        static float cpuFrameMs[GpuProfiler::HISTORY_FRAMES];
+        int count = 0;
+        for (const GpuProfiler::FrameRecord& record : frames) {
+            gpuFrameMs[count] = GpuProfiler::GetFrameGpuMs(record);
+            cpuFrameMs[count] = static_cast<float>((record.CpuEndUs - record.CpuBeginUs) / 1000.0);
+            count++;
+        }
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "%.2f ms", count ? gpuFrameMs[count - 1] : 0.0f);
+        ImGui::PlotLines("GPU", gpuFrameMs, count, 0, overlay, 0.0f, 33.3f, ImVec2(0, 60));
+        std::snprintf(overlay, sizeof(overlay), "%.2f ms", count ? cpuFrameMs[count - 1] : 0.0f);
+        ImGui::PlotLines("CPU", cpuFrameMs, count, 0, overlay, 0.0f, 33.3f, ImVec2(0, 60));
+
+        // Per scope, averaged over the last second or so
+        std::vector<GpuProfiler::ScopeStats> scopes;
+        GpuProfiler::GetAverages(60, scopes);
+        ImGui::Text("%-28s %8s %8s", "Scope", "CPU ms", "GPU ms");
+        for (const GpuProfiler::ScopeStats& scope : scopes) {
+            std::string label = std::string(scope.Depth * 2, ' ') + GpuProfiler::GetName(scope.NameId);
+            ImGui::Text("%-28s %8.3f %8.3f", label.c_str(), scope.CpuMs, scope.GpuMs);
+        }
+        if (GpuProfiler::GetDroppedFrames() > 0)
+            ImGui::Text("Dropped frames (GPU too far behind): %d", GpuProfiler::GetDroppedFrames());
+        if (ImGui::Button("Export Chrome trace"))
+            GpuProfiler::ExportChromeTrace("gpu_trace.json");
+        ImGui::SameLine();
+        ImGui::TextDisabled("open in chrome://tracing or ui.perfetto.dev");
+        ImGui::TextDisabled(Profiler::CompiledIn ? "F9: save CPU scopes of all threads (cpu_trace.json)"
+                                                 : "CPU scope profiler compiled out (CGTP_ENABLE_PROFILER)");
+    }
+
+    if (ImGui::CollapsingHeader("Render Graph")) {
+        // Compiled schedule of this frame: culled passes, auto resolves, target lifetimes, GPU time per pass
+        std::string dump = postProcessor->GetRenderGraph()->Dump();
+        ImGui::TextUnformatted(dump.c_str());
+        if (ImGui::Button("Print to console"))
+            std::cout << dump << std::endl;
+    }
+
+    ImGui::End();
+}
+
+// [New] Live input from the GLFW callbacks: recorded, then queued. Ignored during a replay
+// (except Escape, to stop it)
+static void liveInput(GLFWwindow* window, const InputEvent& e)
+{
+    if (inputRecorder.GetMode() == InputRecorder::REPLAYING) {
+        if (e.EventType == InputEvent::KEY && e.Code == GLFW_KEY_ESCAPE && e.Action == GLFW_PRESS)
+            glfwSetWindowShouldClose(window, true);
+        return;
+    }
+    inputRecorder.Record(e);
+    pendingInput.push_back(e);
+}
+
+// [New] Events are queued as they are polled; a replay queues the frame's logged events here
+void pollInput()
+{
+    const size_t first = pendingInput.size();
+    glfwPollEvents();
+    pendingInput.insert(pendingInput.end(), replayEvents.begin(), replayEvents.end());
+    replayEvents.clear();
+    // [New] Late latch and latency log see the events as they are polled
+    for (size_t i = first; i < pendingInput.size(); i++) {
+        const InputEvent& e = pendingInput[i];
+        lookLatch.Track(e);
+        if (e.EventType == InputEvent::MOUSE_BUTTON && e.Code == GLFW_MOUSE_BUTTON_LEFT && e.Action == GLFW_PRESS
+            && pendingClickTime == std::chrono::steady_clock::time_point())
+            pendingClickTime = std::chrono::steady_clock::now();
+    }
+}
+
+void applyInput(const InputEvent& e)
 {
+    input.Apply(e);
+    if (e.EventType == InputEvent::SCROLL) {
+        camera.ProcessZoom(e.Y);
+        return;
+    }
+    if (e.EventType != InputEvent::CURSOR) return;
+
+    // ƶӽ
     if (isCursorVisible) return; // Don't move camera if cursor is visible
     
-    float xpos = static_cast<float>(xposIn);
-    float ypos = static_cast<float>(yposIn);
+    float xpos = e.X;
+    float ypos = e.Y;
 
     if (firstMouse)
     {
@@ -653,14 +1640,51 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
     camera.ProcessMouseMovement(xoffset, yoffset);
 }
 
+// ƶصӽ
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
+{
+    InputEvent e;
+    e.EventType = InputEvent::CURSOR;
+    e.X = static_cast<float>(xposIn);
+    e.Y = static_cast<float>(yposIn);
+    liveInput(window, e);
+}
+
 // ֻص ()
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 {
-    camera.ProcessZoom(static_cast<float>(yoffset));
+    InputEvent e;
+    e.EventType = InputEvent::SCROLL;
+    e.X = static_cast<float>(xoffset);
+    e.Y = static_cast<float>(yoffset);
+    liveInput(window, e);
+}
+
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    InputEvent e;
+    e.EventType = InputEvent::KEY;
+    e.Code = key;
+    e.Action = action;
+    liveInput(window, e);
+}
+
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    InputEvent e;
+    e.EventType = InputEvent::MOUSE_BUTTON;
+    e.Code = button;
+    e.Action = action;
+    liveInput(window, e);
 }
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    // [Modified] With a render thread the context is not current here: frames carry their size
+    std::unique_lock<std::mutex> state;
+    if (renderThread.IsRunning())
+        state = std::unique_lock<std::mutex>(renderThread.GetStateLock());
+    else
+        glViewport(0, 0, width, height);
     if (postProcessor)
         postProcessor->UpdateSize(width, height);
 }
\ No newline at end of file